@@ -0,0 +1,17 @@
+#include "mini_ros/core/Component.h"
+#include "mini_ros/core/StdMessages.h"
+#include <iostream>
+
+using namespace mini_ros;
+
+// Prints every message on "chatter"
+class ListenerComponent : public Node {
+public:
+    ListenerComponent(const std::string& name, Context& context) : Node(name, context) {
+        createSubscriber<StringMessage>("chatter", [this](std::shared_ptr<StringMessage> msg) {
+            std::cout << getName() << " heard: [" << msg->data << "]" << std::endl;
+        });
+    }
+};
+
+MINI_ROS_REGISTER_COMPONENT(ListenerComponent)
@@ -0,0 +1,25 @@
+#include "mini_ros/core/Component.h"
+#include "mini_ros/core/StdMessages.h"
+#include <iostream>
+
+using namespace mini_ros;
+
+// Publishes a counter on "chatter" once per second
+class TalkerComponent : public Node {
+public:
+    TalkerComponent(const std::string& name, Context& context) : Node(name, context) {
+        pub_ = createPublisher<StringMessage>("chatter");
+        createTimer(std::chrono::seconds(1), [this]() {
+            auto msg = std::make_shared<StringMessage>();
+            msg->data = "Hello from " + getName() + " " + std::to_string(count_++);
+            std::cout << "Talker says: [" << msg->data << "]" << std::endl;
+            pub_->publish(msg);
+        });
+    }
+
+private:
+    std::shared_ptr<Publisher> pub_;
+    int count_ = 0;
+};
+
+MINI_ROS_REGISTER_COMPONENT(TalkerComponent)
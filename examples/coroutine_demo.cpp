@@ -0,0 +1,76 @@
+#include "mini_ros/core/Node.h"
+#include "mini_ros/core/MiniRosCore.h"
+#include "mini_ros/core/StdMessages.h"
+#include "mini_ros/core/StdServices.h"
+#include "mini_ros/core/Coroutine.h"
+#include <iostream>
+#include <thread>
+
+using namespace mini_ros;
+
+// Service server callback
+bool add(AddTwoInts::RequestPtr req, AddTwoInts::ResponsePtr res) {
+    res->sum = req->a + req->b;
+    return true;
+}
+
+// Waits for each counter message, then asks the server to add it to the running total.
+// Neither wait blocks the client node's thread.
+Task<int64_t> accumulate(std::shared_ptr<Subscriber<Int64Message>> sub,
+                         std::shared_ptr<ServiceClient> client, int count) {
+    int64_t total = 0;
+    for (int i = 0; i < count; ++i) {
+        auto msg = co_await sub->next();
+
+        auto req = std::make_shared<AddTwoInts::Request>();
+        req->a = total;
+        req->b = msg->data;
+        auto res = co_await client->call<AddTwoInts>(req);
+        if (!res) {
+            std::cout << "Service call failed." << std::endl;
+            co_return total;
+        }
+        total = res->sum;
+        std::cout << "Coroutine received " << msg->data << ", total " << total << std::endl;
+    }
+    co_return total;
+}
+
+Task<> mainTask(std::shared_ptr<Subscriber<Int64Message>> sub,
+                std::shared_ptr<ServiceClient> client) {
+    int64_t total = co_await accumulate(sub, client, 5);
+    std::cout << "Final total: " << total << std::endl;
+
+    co_await sleep_for(std::chrono::milliseconds(100));
+    MiniRosCore::getInstance().shutdown();
+}
+
+int main() {
+    Node server_node("add_server");
+    Node client_node("coroutine_client");
+
+    auto server = server_node.createServiceServer<AddTwoInts>("add_two_ints", &add);
+    auto pub = server_node.createPublisher<Int64Message>("counter");
+
+    // No callback: messages are consumed with co_await sub->next()
+    auto sub = client_node.createSubscriber<Int64Message>("counter", nullptr);
+    auto client = client_node.createServiceClient<AddTwoInts>("add_two_ints");
+
+    spawn(client_node, mainTask(sub, client));
+
+    std::thread server_thread([&]() { server_node.spin(); });
+    std::thread client_thread([&]() { client_node.spin(); });
+
+    for (int64_t i = 1; i <= 5 && server_node.ok(); ++i) {
+        auto msg = std::make_shared<Int64Message>();
+        msg->data = i;
+        pub->publish(msg);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    server_thread.join();
+    client_thread.join();
+
+    std::cout << "Coroutine demo finished." << std::endl;
+    return 0;
+}
@@ -9,6 +9,7 @@ using namespace mini_ros;
 
 std::shared_ptr<Subscriber<Int64Message>> sub;
 std::shared_ptr<Timer> timer;
+Node* listener = nullptr;
 
 void perfCallback(std::shared_ptr<Int64Message> msg) {
     // Do a tiny bit of "work"
@@ -23,6 +24,8 @@ void timerCallback() {
     auto subStats = sub->getStats();
     auto latencyStats = sub->getLatencyStats();
     auto timerStats = timer->getStats();
+    auto subProfile = sub->getProfile();
+    auto executorStats = listener->getExecutorStats();
     
     std::cout << std::fixed << std::setprecision(5);
     std::cout << "--- Performance Stats ---" << std::endl;
@@ -39,6 +42,14 @@ void timerCallback() {
     std::cout << "Timer Callback (us):      "
               << "mean=" << timerStats.mean() * 1e6
               << " max=" << timerStats.max() * 1e6 << std::endl;
+    std::cout << "Subscriber CPU Time (us): "
+              << "mean=" << subProfile.cpuTime.mean() * 1e6
+              << " max=" << subProfile.cpuTime.max() * 1e6
+              << " ctx_switches/cb=" << subProfile.contextSwitches.mean()
+              << " page_faults/cb=" << subProfile.pageFaults.mean() << std::endl;
+
+    std::cout << "Listener Executor:        "
+              << "busy=" << executorStats.busyRatio() * 100.0 << "%" << std::endl;
     std::cout << "Total Msgs: " << subStats.count() << std::endl;
     std::cout << "-------------------------" << std::endl;
 }
@@ -46,6 +57,7 @@ void timerCallback() {
 int main() {
     Node publisher_node("publisher");
     Node listener_node("listener");
+    listener = &listener_node;
 
     auto pub = publisher_node.createPublisher<Int64Message>("perf_topic");
     sub = listener_node.createSubscriber<Int64Message>("perf_topic", &perfCallback);
@@ -53,6 +65,9 @@ int main() {
     // Create a timer in the listener node to print stats
     timer = listener_node.createTimer(std::chrono::seconds(2), &timerCallback);
 
+    // CPU time and kernel counters per callback
+    listener_node.setProfilingEnabled(true);
+
     // Run listener in its own thread
     std::thread listener_thread([&]() {
         listener_node.spin();
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mini_ros {
+
+// Cache-line / AVX-512 friendly alignment used by all large message payloads
+constexpr size_t kBufferAlignment = 64;
+
+// Source of raw payload memory. The default uses aligned heap allocations;
+// implement this over a pool or a shared-memory segment to back messages there.
+class BufferAllocator {
+public:
+    virtual ~BufferAllocator() = default;
+    // Must return memory aligned to at least kBufferAlignment, or nullptr on failure
+    virtual void* allocate(size_t bytes) = 0;
+    virtual void deallocate(void* ptr, size_t bytes) = 0;
+};
+
+class HeapBufferAllocator : public BufferAllocator {
+public:
+    void* allocate(size_t bytes) override {
+        return ::operator new(bytes, std::align_val_t(kBufferAlignment), std::nothrow);
+    }
+
+    void deallocate(void* ptr, size_t /*bytes*/) override {
+        ::operator delete(ptr, std::align_val_t(kBufferAlignment));
+    }
+
+    static HeapBufferAllocator& instance() {
+        static HeapBufferAllocator allocator;
+        return allocator;
+    }
+};
+
+// Growable array of trivially copyable elements whose storage is always
+// kBufferAlignment-aligned. Capacity is padded to a whole number of
+// alignment blocks so SIMD kernels can safely load full vectors.
+template<typename T>
+class AlignedBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "AlignedBuffer requires trivially copyable elements");
+
+public:
+    explicit AlignedBuffer(BufferAllocator* allocator = &HeapBufferAllocator::instance())
+        : allocator_(allocator) {}
+
+    AlignedBuffer(size_t count, BufferAllocator* allocator = &HeapBufferAllocator::instance())
+        : allocator_(allocator) {
+        resize(count);
+    }
+
+    ~AlignedBuffer() { release(); }
+
+    AlignedBuffer(const AlignedBuffer& other) : allocator_(other.allocator_) {
+        resize(other.size_);
+        if (size_) std::memcpy(data_, other.data_, size_ * sizeof(T));
+    }
+
+    AlignedBuffer& operator=(const AlignedBuffer& other) {
+        if (this != &other) {
+            resize(other.size_);
+            if (size_) std::memcpy(data_, other.data_, size_ * sizeof(T));
+        }
+        return *this;
+    }
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : allocator_(other.allocator_),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            allocator_ = other.allocator_;
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        return *this;
+    }
+
+    void reserve(size_t count) {
+        if (count <= capacity_) return;
+        size_t bytes = roundUp(count * sizeof(T));
+        T* newData = static_cast<T*>(allocator_->allocate(bytes));
+        if (!newData) throw std::bad_alloc();
+        if (size_) std::memcpy(newData, data_, size_ * sizeof(T));
+        release();
+        data_ = newData;
+        capacity_ = bytes / sizeof(T);
+    }
+
+    // New elements are left uninitialized
+    void resize(size_t count) {
+        reserve(count);
+        size_ = count;
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) reserve(capacity_ ? capacity_ * 2 : kBufferAlignment / sizeof(T) + 1);
+        data_[size_++] = value;
+    }
+
+    void clear() { size_ = 0; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    size_t bytes() const { return size_ * sizeof(T); }
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+    BufferAllocator* allocator() const { return allocator_; }
+
+private:
+    static size_t roundUp(size_t bytes) {
+        return (bytes + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+    }
+
+    void release() {
+        if (data_) {
+            allocator_->deallocate(data_, capacity_ * sizeof(T));
+            data_ = nullptr;
+        }
+        capacity_ = 0;
+    }
+
+    BufferAllocator* allocator_;
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+} // namespace mini_ros
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Statistics.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mini_ros {
+
+// Per-thread kernel counters for the calling thread. Uses perf_event_open
+// software counters when the kernel allows it, falls back to
+// getrusage(RUSAGE_THREAD), and reports nothing on other platforms.
+class ThreadCounters {
+public:
+    enum class Source { PerfEvent, Rusage, None };
+
+    struct Sample {
+        double cpuSeconds = 0.0;
+        uint64_t contextSwitches = 0;
+        uint64_t pageFaults = 0;
+    };
+
+    // Counters for the calling thread, opened on first use
+    static ThreadCounters& current() {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    Source source() const { return source_; }
+
+    Sample read() const {
+        Sample sample;
+        sample.cpuSeconds = threadCpuSeconds();
+#if defined(__linux__)
+        if (source_ == Source::PerfEvent) {
+            sample.contextSwitches = readCounter(contextSwitchFd_);
+            sample.pageFaults = readCounter(pageFaultFd_);
+        } else if (source_ == Source::Rusage) {
+            struct rusage usage;
+            if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+                sample.contextSwitches = static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw);
+                sample.pageFaults = static_cast<uint64_t>(usage.ru_minflt + usage.ru_majflt);
+            }
+        }
+#endif
+        return sample;
+    }
+
+    ~ThreadCounters() {
+#if defined(__linux__)
+        if (contextSwitchFd_ >= 0) close(contextSwitchFd_);
+        if (pageFaultFd_ >= 0) close(pageFaultFd_);
+#endif
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+private:
+    ThreadCounters() {
+#if defined(__linux__)
+        contextSwitchFd_ = openCounter(PERF_COUNT_SW_CONTEXT_SWITCHES);
+        pageFaultFd_ = openCounter(PERF_COUNT_SW_PAGE_FAULTS);
+        if (contextSwitchFd_ >= 0 && pageFaultFd_ >= 0) {
+            source_ = Source::PerfEvent;
+        } else {
+            // perf_event_paranoid or a seccomp filter said no
+            if (contextSwitchFd_ >= 0) close(contextSwitchFd_);
+            if (pageFaultFd_ >= 0) close(pageFaultFd_);
+            contextSwitchFd_ = pageFaultFd_ = -1;
+            source_ = Source::Rusage;
+        }
+#endif
+    }
+
+    static double threadCpuSeconds() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+        struct timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+            return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+        }
+#endif
+        return 0.0;
+    }
+
+#if defined(__linux__)
+    static int openCounter(uint64_t config) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_SOFTWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 0;
+        attr.exclude_hv = 1;
+        // pid = 0, cpu = -1: this thread on any CPU
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static uint64_t readCounter(int fd) {
+        uint64_t value = 0;
+        if (::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) return 0;
+        return value;
+    }
+
+    int contextSwitchFd_ = -1;
+    int pageFaultFd_ = -1;
+#endif
+    Source source_ = Source::None;
+};
+
+// CPU time and kernel counters per callback invocation, kept next to the
+// wall-clock Statistics of a subscriber, service server or timer. Comparing
+// CPU time with wall time shows whether a slow callback was computing or was
+// preempted/blocked; context switches and page faults say which.
+class CallbackProfile {
+public:
+    Statistics cpuTime;         // Seconds of thread CPU time
+    Statistics contextSwitches; // Voluntary + involuntary
+    Statistics pageFaults;      // Minor + major
+};
+
+// Profiles one callback invocation into `profile` if it is non-null
+class ProfileScope {
+public:
+    explicit ProfileScope(CallbackProfile* profile) : profile_(profile) {
+        if (profile_) start_ = ThreadCounters::current().read();
+    }
+
+    ~ProfileScope() {
+        if (!profile_) return;
+        auto end = ThreadCounters::current().read();
+        profile_->cpuTime.add(end.cpuSeconds - start_.cpuSeconds);
+        profile_->contextSwitches.add(static_cast<double>(end.contextSwitches - start_.contextSwitches));
+        profile_->pageFaults.add(static_cast<double>(end.pageFaults - start_.pageFaults));
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    CallbackProfile* profile_;
+    ThreadCounters::Sample start_;
+};
+
+} // namespace mini_ros
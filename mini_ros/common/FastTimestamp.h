@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <thread>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MINI_ROS_HAS_RDTSC 1
+#endif
+
+namespace mini_ros {
+
+// Cheap monotonic timestamps for hot paths (publish, delivery, stats).
+// Reads the TSC with rdtsc when the CPU reports an invariant TSC (constant
+// rate across P-states and cores), calibrated once against steady_clock;
+// otherwise falls back to steady_clock. CLOCK_MONOTONIC_COARSE can be
+// selected explicitly when millisecond resolution is enough.
+//
+// Ticks are only meaningful relative to each other; use it for durations, not
+// for absolute time. The first call calibrates (~10 ms); MiniRosCore does that
+// up front through warmUp() so it never lands on a publish or a callback.
+class FastTimestamp {
+public:
+    enum class Source { Tsc, MonotonicCoarse, SteadyClock };
+    using Ticks = uint64_t;
+
+    static Ticks now() {
+        switch (state().source) {
+#if defined(MINI_ROS_HAS_RDTSC)
+        case Source::Tsc:
+            return __rdtsc();
+#endif
+#if defined(CLOCK_MONOTONIC_COARSE)
+        case Source::MonotonicCoarse: {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+            return static_cast<Ticks>(ts.tv_sec) * 1000000000ull + static_cast<Ticks>(ts.tv_nsec);
+        }
+#endif
+        default:
+            return steadyNanos();
+        }
+    }
+
+    // Nanoseconds since an arbitrary origin shared by all readings
+    static int64_t toNanos(Ticks ticks) {
+        const State& s = state();
+        return static_cast<int64_t>(static_cast<double>(ticks - s.baseTicks) * s.nanosPerTick);
+    }
+
+    static int64_t nanos() { return toNanos(now()); }
+
+    // Seconds between two readings
+    static double elapsedSeconds(Ticks start, Ticks end) {
+        return static_cast<double>(end - start) * state().nanosPerTick * 1e-9;
+    }
+
+    // Runs the one-time calibration now instead of on the first timestamp
+    static void warmUp() { state(); }
+
+    static Source source() { return state().source; }
+    static double ticksPerSecond() { return 1e9 / state().nanosPerTick; }
+
+    // Requests a source before the first timestamp is taken. Returns false if
+    // timestamps are already in use or `source` is unavailable here.
+    static bool prefer(Source source) {
+        if (!available(source)) return false;
+        requested().store(static_cast<int>(source), std::memory_order_relaxed);
+        return !initialized().load(std::memory_order_acquire);
+    }
+
+    static bool available(Source source) {
+        switch (source) {
+        case Source::Tsc:
+            return hasInvariantTsc();
+        case Source::MonotonicCoarse:
+#if defined(CLOCK_MONOTONIC_COARSE)
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return true;
+        }
+    }
+
+private:
+    struct State {
+        Source source = Source::SteadyClock;
+        Ticks baseTicks = 0;
+        double nanosPerTick = 1.0;
+    };
+
+    static std::atomic<int>& requested() {
+        static std::atomic<int> source{-1}; // -1 = pick the best available
+        return source;
+    }
+
+    static std::atomic<bool>& initialized() {
+        static std::atomic<bool> flag{false};
+        return flag;
+    }
+
+    static const State& state() {
+        static const State s = calibrate();
+        return s;
+    }
+
+    static State calibrate() {
+        State s;
+        int req = requested().load(std::memory_order_relaxed);
+        s.source = req >= 0 ? static_cast<Source>(req)
+                            : (hasInvariantTsc() ? Source::Tsc : Source::SteadyClock);
+#if defined(MINI_ROS_HAS_RDTSC)
+        if (s.source == Source::Tsc) {
+            // Bracket each steady_clock read with rdtsc to bound the pairing error
+            auto sample = [](Ticks& tsc, int64_t& ns) {
+                Ticks before = __rdtsc();
+                ns = steadyNanos();
+                Ticks after = __rdtsc();
+                tsc = before + (after - before) / 2;
+            };
+            Ticks tsc0, tsc1;
+            int64_t ns0, ns1;
+            sample(tsc0, ns0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            sample(tsc1, ns1);
+            if (tsc1 > tsc0 && ns1 > ns0) {
+                s.nanosPerTick = static_cast<double>(ns1 - ns0) / static_cast<double>(tsc1 - tsc0);
+                s.baseTicks = tsc0;
+            } else {
+                s.source = Source::SteadyClock;
+            }
+        }
+#endif
+        initialized().store(true, std::memory_order_release);
+        return s;
+    }
+
+    static bool hasInvariantTsc() {
+#if defined(MINI_ROS_HAS_RDTSC)
+        unsigned int eax, ebx, ecx, edx;
+        // CPUID.80000007H:EDX[8] = invariant TSC
+        if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+            return (edx & (1u << 8)) != 0;
+        }
+#endif
+        return false;
+    }
+
+    static Ticks steadyNanos() {
+        return static_cast<Ticks>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+} // namespace mini_ros
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace mini_ros {
+
+// Lock-free log-linear histogram of non-negative integer values (e.g.
+// nanoseconds). Each power-of-two range is split into 64 sub-buckets, so
+// reported percentiles are within ~1.6% of the true value across the whole
+// 64-bit range. Statistics only keeps moments; use this for tail latency.
+class LatencyHistogram {
+public:
+    LatencyHistogram() {
+        for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(int64_t value) {
+        uint64_t v = value < 0 ? 0 : static_cast<uint64_t>(value);
+        buckets_[indexOf(v)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(v, std::memory_order_relaxed);
+        uint64_t current = max_.load(std::memory_order_relaxed);
+        while (v > current && !max_.compare_exchange_weak(current, v, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    double mean() const {
+        uint64_t n = count();
+        return n ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / n : 0.0;
+    }
+
+    // Value at `percentile` (0-100), or 0 when empty
+    uint64_t percentile(double percentile) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(std::max(1.0, percentile / 100.0 * n + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) return std::min(valueOf(i), max());
+        }
+        return max();
+    }
+
+    void reset() {
+        for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr int kSubBits = 7; // 2^7 exact values, then 64 sub-buckets per octave
+    static constexpr uint64_t kExact = 1ull << kSubBits;
+    static constexpr uint64_t kHalf = kExact / 2;
+    static constexpr size_t kBuckets = kExact + (64 - kSubBits) * kHalf;
+
+    static int highestBit(uint64_t v) {
+        int bit = 0;
+        while (v >>= 1) ++bit;
+        return bit;
+    }
+
+    static size_t indexOf(uint64_t v) {
+        if (v < kExact) return static_cast<size_t>(v);
+        int shift = highestBit(v) - (kSubBits - 1);
+        uint64_t top = v >> shift; // In [kHalf, kExact)
+        return static_cast<size_t>(kExact + (shift - 1) * kHalf + (top - kHalf));
+    }
+
+    // Midpoint of the bucket's range
+    static uint64_t valueOf(size_t index) {
+        if (index < kExact) return index;
+        uint64_t k = index - kExact;
+        int shift = static_cast<int>(k / kHalf) + 1;
+        uint64_t top = k % kHalf + kHalf;
+        return (top << shift) + ((1ull << shift) >> 1);
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace mini_ros
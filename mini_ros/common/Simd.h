@@ -0,0 +1,45 @@
+#pragma once
+
+// Runtime SIMD dispatch shared by the vectorized kernels (MessageKernels,
+// DeltaCodec). Each kernel picks a path with switch (simd()).
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#define MINI_ROS_HAS_SSE2 1
+#endif
+
+// AVX and AVX2 code is compiled per-function so the library still runs on CPUs without it
+#if defined(MINI_ROS_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define MINI_ROS_HAS_AVX 1
+#define MINI_ROS_HAS_AVX2 1
+#define MINI_ROS_TARGET_AVX __attribute__((target("avx")))
+#define MINI_ROS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace mini_ros {
+
+// Widest instruction set on this machine. Each level implies the ones before
+// it, so a kernel without an AVX2 path handles Avx2 like Avx.
+enum class SimdLevel { Scalar, Sse2, Avx, Avx2 };
+
+inline SimdLevel detectSimdLevel() {
+#if defined(MINI_ROS_HAS_AVX2)
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+#endif
+#if defined(MINI_ROS_HAS_AVX)
+    if (__builtin_cpu_supports("avx")) return SimdLevel::Avx;
+#endif
+#if defined(MINI_ROS_HAS_SSE2)
+    return SimdLevel::Sse2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Detected once per process
+inline SimdLevel simd() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+} // namespace mini_ros
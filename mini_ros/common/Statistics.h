@@ -19,6 +19,28 @@ public:
           sum_(0.0),
           sumSq_(0.0) {}
 
+    // Copies take a consistent snapshot (used by the getStats() accessors)
+    Statistics(const Statistics& other) {
+        std::lock_guard<std::mutex> lock(other.mutex_);
+        min_ = other.min_;
+        max_ = other.max_;
+        count_ = other.count_;
+        sum_ = other.sum_;
+        sumSq_ = other.sumSq_;
+    }
+
+    Statistics& operator=(const Statistics& other) {
+        if (this != &other) {
+            std::scoped_lock lock(mutex_, other.mutex_);
+            min_ = other.min_;
+            max_ = other.max_;
+            count_ = other.count_;
+            sum_ = other.sum_;
+            sumSq_ = other.sumSq_;
+        }
+        return *this;
+    }
+
     void add(double value) {
         std::lock_guard<std::mutex> lock(mutex_);
         if (value < min_) min_ = value;
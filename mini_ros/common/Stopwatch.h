@@ -1,35 +1,30 @@
 #pragma once
 
-#include <chrono>
+#include "FastTimestamp.h"
 
 namespace mini_ros {
 
+// Measures elapsed time with FastTimestamp, so timing every callback stays cheap
 class Stopwatch {
 public:
-    using Clock = std::chrono::high_resolution_clock;
-
-    Stopwatch() : startTime_(Clock::now()) {}
+    Stopwatch() : startTicks_(FastTimestamp::now()) {}
 
     void reset() {
-        startTime_ = Clock::now();
+        startTicks_ = FastTimestamp::now();
     }
 
     // Returns elapsed time in seconds
     double elapsed() const {
-        auto endTime = Clock::now();
-        std::chrono::duration<double> diff = endTime - startTime_;
-        return diff.count();
+        return FastTimestamp::elapsedSeconds(startTicks_, FastTimestamp::now());
     }
     
     // Returns elapsed time in milliseconds
     double elapsed_ms() const {
-        auto endTime = Clock::now();
-        std::chrono::duration<double, std::milli> diff = endTime - startTime_;
-        return diff.count();
+        return elapsed() * 1e3;
     }
 
 private:
-    std::chrono::time_point<Clock> startTime_;
+    FastTimestamp::Ticks startTicks_;
 };
 
-} // namespace mini_ros
\ No newline at end of file
+} // namespace mini_ros
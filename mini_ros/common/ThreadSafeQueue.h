@@ -18,6 +18,17 @@ public:
         cond_var_.notify_one();
     }
 
+    // Pushes [first, last) under a single lock with a single wake-up
+    template<typename InputIt>
+    void push_bulk(InputIt first, InputIt last) {
+        if (first == last) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (; first != last; ++first) {
+            queue_.push(*first);
+        }
+        cond_var_.notify_all();
+    }
+
     bool try_pop(T& value) {
         std::lock_guard<std::mutex> lock(mutex_);
         if (queue_.empty()) {
@@ -28,6 +39,18 @@ public:
         return true;
     }
 
+    // Pops the front element only if `pred(front)` holds
+    template<typename Pred>
+    bool try_pop_if(Pred pred, T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty() || !pred(queue_.front())) {
+            return false;
+        }
+        value = std::move(queue_.front());
+        queue_.pop();
+        return true;
+    }
+
     std::shared_ptr<T> try_pop() {
         std::lock_guard<std::mutex> lock(mutex_);
         if (queue_.empty()) {
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../common/FastTimestamp.h"
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mini_ros {
+
+// Source of "now" for message timestamps, latency stats, timers and timeouts
+class Clock {
+public:
+    // Same representation as IMessage::timestamp
+    using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+    using Duration = TimePoint::duration;
+
+    virtual ~Clock() = default;
+    virtual TimePoint now() const = 0;
+};
+
+// Wall-clock time (the default)
+class SystemClock : public Clock {
+public:
+    TimePoint now() const override { return std::chrono::high_resolution_clock::now(); }
+};
+
+// Opt-in approximation of wall-clock time: anchored to the system clock once,
+// then advanced by FastTimestamp. Cheaper per call than SystemClock and
+// monotonic, but it drifts from wall time by the TSC calibration error (tens
+// to hundreds of ppm) and ignores NTP adjustments, so timestamps disagree
+// with other processes over time. Only for single-process setups that care
+// more about stamp cost than about absolute time.
+class FastClock : public Clock {
+public:
+    TimePoint now() const override { return read(); }
+
+    static TimePoint read() {
+        static const Anchor anchor;
+        return anchor.system + std::chrono::duration_cast<Duration>(
+            std::chrono::nanoseconds(FastTimestamp::nanos() - anchor.nanos));
+    }
+
+private:
+    struct Anchor {
+        TimePoint system = std::chrono::high_resolution_clock::now();
+        int64_t nanos = FastTimestamp::nanos();
+    };
+};
+
+// Deterministic clock that only moves when told to. Use it to drive tests
+// and scenarios faster than real time: advance(), then spinOnce() the nodes.
+class SteppedClock : public Clock {
+public:
+    explicit SteppedClock(TimePoint start = TimePoint()) : nanos_(toNanos(start)) {}
+
+    TimePoint now() const override {
+        return TimePoint(std::chrono::duration_cast<Duration>(
+            std::chrono::nanoseconds(nanos_.load(std::memory_order_acquire))));
+    }
+
+    void setTime(TimePoint t) { nanos_.store(toNanos(t), std::memory_order_release); }
+
+    void advance(std::chrono::duration<double> step) {
+        nanos_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(step).count(),
+                         std::memory_order_acq_rel);
+    }
+
+private:
+    static int64_t toNanos(TimePoint t) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    std::atomic<int64_t> nanos_;
+};
+
+// Stable handle to the clock currently selected on a MiniRosCore. Timers,
+// subscribers and clients keep a pointer to this rather than to a Clock so
+// the core can switch clocks at runtime. Deadlines taken on an earlier clock
+// are meaningless on the new one; holders compare generation() to notice a
+// switch and re-base them.
+class TimeSource {
+public:
+    TimeSource() : current_(nullptr) { set(std::make_shared<SystemClock>()); }
+
+    Clock::TimePoint now() const {
+        return current_.load(std::memory_order_acquire)->now();
+    }
+
+    void set(std::shared_ptr<Clock> clock) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Retired clocks stay alive: readers may still hold the old raw pointer
+        owned_.push_back(clock);
+        current_.store(clock.get(), std::memory_order_release);
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    // Bumped by every set()
+    uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+    std::shared_ptr<Clock> get() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return owned_.back();
+    }
+
+private:
+    std::atomic<Clock*> current_;
+    std::atomic<uint64_t> generation_{0};
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Clock>> owned_;
+};
+
+} // namespace mini_ros
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Node.h"
+#include <string>
+
+namespace mini_ros {
+
+// Composable node components.
+//
+// A component is a Node subclass constructible from (name, context), built
+// into a shared library and registered with MINI_ROS_REGISTER_COMPONENT.
+// The component container (mini_ros_container) dlopen()s the libraries listed
+// in a config file and runs every component in one process and one context,
+// so topics between them use the in-process zero-copy path.
+//
+//   class Talker : public mini_ros::Node {
+//   public:
+//       Talker(const std::string& name, mini_ros::Context& context)
+//           : Node(name, context) { ... }
+//   };
+//   MINI_ROS_REGISTER_COMPONENT(Talker)
+
+// Signature of the factory each registered component exports
+using ComponentFactory = Node* (*)(const std::string& name, Context& context);
+
+// Exported symbol name for component class `className`
+inline std::string componentSymbol(const std::string& className) {
+    return "mini_ros_component_" + className;
+}
+
+} // namespace mini_ros
+
+// `ClassT` must be an unqualified name (add a using-declaration for classes
+// inside namespaces); the container refers to the component by that name.
+#define MINI_ROS_REGISTER_COMPONENT(ClassT)                                              \
+    extern "C" mini_ros::Node* mini_ros_component_##ClassT(const std::string& name,      \
+                                                            mini_ros::Context& context) { \
+        return new ClassT(name, context);                                                \
+    }
@@ -0,0 +1,77 @@
+#include "ComponentLoader.h"
+#include "MiniRosCore.h"
+#include <dlfcn.h>
+#include <fstream>
+#include <sstream>
+
+namespace mini_ros {
+
+ComponentLoader::ComponentLoader(Context& context) : context_(context) {
+}
+
+ComponentLoader::~ComponentLoader() {
+    // Node code lives in the libraries, so nodes must go first
+    nodes_.clear();
+    for (auto it = libraries_.rbegin(); it != libraries_.rend(); ++it) {
+        dlclose(*it);
+    }
+}
+
+Node* ComponentLoader::load(const ComponentSpec& spec) {
+    void* library = nullptr;
+    for (size_t i = 0; i < libraryPaths_.size(); ++i) {
+        if (libraryPaths_[i] == spec.library) {
+            library = libraries_[i];
+            break;
+        }
+    }
+
+    if (!library) {
+        library = dlopen(spec.library.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            lastError_ = dlerror();
+            return nullptr;
+        }
+        libraries_.push_back(library);
+        libraryPaths_.push_back(spec.library);
+    }
+
+    dlerror(); // Clear any stale error
+    auto factory = reinterpret_cast<ComponentFactory>(
+        dlsym(library, componentSymbol(spec.className).c_str()));
+    if (!factory) {
+        lastError_ = "component '" + spec.className + "' not registered in " + spec.library;
+        return nullptr;
+    }
+
+    nodes_.emplace_back(factory(spec.nodeName, context_));
+    return nodes_.back().get();
+}
+
+bool ComponentLoader::parseConfig(const std::string& path, std::vector<ComponentSpec>& specs,
+                                  std::string* error) {
+    std::ifstream file(path);
+    if (!file) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream fields(line);
+        ComponentSpec spec;
+        if (!(fields >> spec.library) || spec.library[0] == '#') {
+            continue; // Blank line or comment
+        }
+        if (!(fields >> spec.className >> spec.nodeName)) {
+            if (error) *error = path + ":" + std::to_string(lineNumber) + ": expected <library> <class> <node_name>";
+            return false;
+        }
+        specs.push_back(spec);
+    }
+    return true;
+}
+
+} // namespace mini_ros
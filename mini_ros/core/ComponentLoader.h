@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Component.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mini_ros {
+
+// One line of a component container config file
+struct ComponentSpec {
+    std::string library;   // Path passed to dlopen()
+    std::string className; // Name given to MINI_ROS_REGISTER_COMPONENT
+    std::string nodeName;
+};
+
+// Loads component libraries and owns the nodes created from them
+class ComponentLoader {
+public:
+    explicit ComponentLoader(Context& context);
+    // Destroys all nodes, then unloads their libraries
+    ~ComponentLoader();
+
+    ComponentLoader(const ComponentLoader&) = delete;
+    ComponentLoader& operator=(const ComponentLoader&) = delete;
+
+    // Returns the new node, or nullptr on failure (see lastError())
+    Node* load(const ComponentSpec& spec);
+
+    const std::vector<std::unique_ptr<Node>>& nodes() const { return nodes_; }
+    const std::string& lastError() const { return lastError_; }
+
+    // Parses a config file with one "<library> <ComponentClass> <node_name>"
+    // entry per line; blank lines and lines starting with '#' are ignored.
+    // Returns false if the file cannot be read or a line is malformed.
+    static bool parseConfig(const std::string& path, std::vector<ComponentSpec>& specs,
+                            std::string* error = nullptr);
+
+private:
+    Context& context_;
+    std::vector<void*> libraries_; // dlopen() handles, each opened once
+    std::vector<std::string> libraryPaths_;
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::string lastError_;
+};
+
+} // namespace mini_ros
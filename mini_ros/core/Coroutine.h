@@ -0,0 +1,259 @@
+#pragma once
+
+// Opt-in C++20 coroutine layer. Configure with -DMINI_ROS_ENABLE_COROUTINES=ON.
+//
+// Coroutines run on a Node's spinning thread and never block it: while a task
+// is suspended in co_await, the node keeps servicing its other callbacks.
+//
+//   Task<> worker(std::shared_ptr<ServiceClient> client) {
+//       auto res = co_await client->call<AddTwoInts>(req);
+//       auto msg = co_await sub->next();
+//       co_await sleep_for(std::chrono::milliseconds(10));
+//   }
+//   spawn(node, worker(client));
+
+#if !defined(__cpp_impl_coroutine)
+#error "mini_ros/core/Coroutine.h requires C++20 coroutines (configure with -DMINI_ROS_ENABLE_COROUTINES=ON)"
+#endif
+
+#include "Node.h"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <chrono>
+#include <thread>
+
+namespace mini_ros {
+
+namespace detail {
+
+// State shared by all Task promise types
+struct TaskPromiseBase {
+    Node* node = nullptr; // Executor the task resumes on (inherited by awaited sub-tasks)
+    std::coroutine_handle<> continuation; // Awaiting parent task, if any
+    bool detached = false; // Started with spawn(); frees itself on completion
+    std::exception_ptr exception;
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        template<class PromiseT>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> h) noexcept {
+            auto& promise = h.promise();
+            if (promise.continuation) {
+                return promise.continuation; // Resume the parent (symmetric transfer)
+            }
+            if (promise.detached) {
+                // Like std::thread, an exception escaping a detached task is fatal
+                if (promise.exception) std::terminate();
+                h.destroy();
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() { exception = std::current_exception(); }
+};
+
+// Resume `h` on `node`'s spinning thread (or inline if it has no node)
+inline void resumeOn(Node* node, std::coroutine_handle<> h) {
+    if (node) {
+        node->post([h]() { h.resume(); });
+    } else {
+        h.resume();
+    }
+}
+
+} // namespace detail
+
+template<class T>
+class Task;
+
+namespace detail {
+
+template<class T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+
+    template<class U>
+    void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+
+    T result() {
+        if (exception) std::rethrow_exception(exception);
+        return std::move(*value);
+    }
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+
+    void return_void() {}
+
+    void result() {
+        if (exception) std::rethrow_exception(exception);
+    }
+};
+
+template<class T>
+struct TaskAwaiter {
+    std::coroutine_handle<TaskPromise<T>> handle;
+
+    bool await_ready() noexcept { return !handle || handle.done(); }
+
+    template<class ParentPromiseT>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<ParentPromiseT> parent) noexcept {
+        handle.promise().node = parent.promise().node;
+        handle.promise().continuation = parent;
+        return handle;
+    }
+
+    T await_resume() { return handle.promise().result(); }
+};
+
+} // namespace detail
+
+// Lazily started coroutine. co_await it from another Task, or hand a Task<void>
+// to spawn() to run it on a node.
+template<class T = void>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using HandleT = std::coroutine_handle<promise_type>;
+
+    explicit Task(HandleT h) : handle_(h) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+    auto operator co_await() && noexcept { return detail::TaskAwaiter<T>{handle_}; }
+
+    // Release ownership of the coroutine frame (used by spawn())
+    HandleT release() noexcept { return std::exchange(handle_, {}); }
+
+private:
+    HandleT handle_;
+};
+
+namespace detail {
+
+template<class T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+// Start `task` on `node`. The task runs during node.spin()/spinOnce() and
+// frees itself when it finishes.
+inline void spawn(Node& node, Task<void> task) {
+    auto handle = task.release();
+    if (!handle) return;
+    handle.promise().node = &node;
+    handle.promise().detached = true;
+    node.post([handle]() { handle.resume(); });
+}
+
+// co_await sleep_for(period): suspend the task without blocking the node
+struct SleepAwaiter {
+    std::chrono::duration<double> delay;
+
+    bool await_ready() const noexcept { return delay.count() <= 0.0; }
+
+    template<class PromiseT>
+    bool await_suspend(std::coroutine_handle<PromiseT> h) {
+        Node* node = h.promise().node;
+        if (!node) {
+            // Not running on an executor; fall back to a blocking sleep
+            std::this_thread::sleep_for(delay);
+            return false;
+        }
+        node->postAfter(delay, [h]() { h.resume(); });
+        return true;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+inline SleepAwaiter sleep_for(std::chrono::duration<double> delay) {
+    return SleepAwaiter{delay};
+}
+
+namespace detail {
+
+template<class SrvT>
+struct CallAwaiter {
+    AsyncCall<SrvT> call;
+    typename SrvT::ResponsePtr response;
+
+    bool await_ready() const noexcept { return false; }
+
+    template<class PromiseT>
+    bool await_suspend(std::coroutine_handle<PromiseT> h) {
+        Node* node = h.promise().node;
+        return call.then([this, node, h](typename SrvT::ResponsePtr res) {
+            response = std::move(res);
+            resumeOn(node, h);
+        }); // Service not found: resume immediately with nullptr
+    }
+
+    typename SrvT::ResponsePtr await_resume() { return std::move(response); }
+};
+
+template<class MsgT>
+struct NextAwaiter {
+    NextMessage<MsgT> next;
+    std::shared_ptr<MsgT> message;
+
+    bool await_ready() const noexcept { return false; }
+
+    template<class PromiseT>
+    void await_suspend(std::coroutine_handle<PromiseT> h) {
+        Node* node = h.promise().node;
+        next.then([this, node, h](std::shared_ptr<MsgT> msg) {
+            message = std::move(msg);
+            resumeOn(node, h);
+        });
+    }
+
+    std::shared_ptr<MsgT> await_resume() { return std::move(message); }
+};
+
+} // namespace detail
+
+// co_await client->call<SrvT>(req): resumes with the response, or nullptr if
+// the service is not available or the server callback failed
+template<class SrvT>
+detail::CallAwaiter<SrvT> operator co_await(AsyncCall<SrvT> call) {
+    return detail::CallAwaiter<SrvT>{call, nullptr};
+}
+
+// co_await sub->next(): resumes with the next message delivered to the subscriber
+template<class MsgT>
+detail::NextAwaiter<MsgT> operator co_await(NextMessage<MsgT> next) {
+    return detail::NextAwaiter<MsgT>{next, nullptr};
+}
+
+} // namespace mini_ros
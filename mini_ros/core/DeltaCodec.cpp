@@ -0,0 +1,425 @@
+#include "DeltaCodec.h"
+#include "../common/Simd.h"
+#include <cstring>
+
+namespace mini_ros {
+
+namespace {
+
+// Frame layout (little-endian):
+//   uint8  flags
+//   uint8  sequence (wraps)
+//   varint payload size          keyframes only
+//   uint32 checksum              if kFlagChecksum
+//   body: raw payload (keyframe) or varint-coded word deltas (delta frame)
+constexpr uint8_t kFlagKeyframe = 0x01;
+constexpr uint8_t kFlagArithmetic = 0x02;
+constexpr uint8_t kFlagChecksum = 0x04;
+constexpr uint8_t kKnownFlags = kFlagKeyframe | kFlagArithmetic | kFlagChecksum;
+
+// --- varint / zigzag ---
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+size_t varintLength(uint64_t value) {
+    size_t length = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++length;
+    }
+    return length;
+}
+
+bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false; // Truncated or longer than 10 bytes
+}
+
+inline uint64_t zigzag(uint64_t diff) {
+    return (diff << 1) ^ (0 - (diff >> 63));
+}
+
+inline uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+// --- word transforms ---
+// Each vector path processes whole blocks and returns how many words it
+// handled; the scalar loop finishes the tail.
+
+void forwardScalar(const uint64_t* cur, const uint64_t* prev, uint64_t* out,
+                   size_t begin, size_t end, bool arithmetic) {
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = arithmetic ? zigzag(cur[i] - prev[i]) : cur[i] ^ prev[i];
+    }
+}
+
+void inverseScalar(const uint64_t* delta, const uint64_t* prev, uint64_t* out,
+                   size_t begin, size_t end, bool arithmetic) {
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = arithmetic ? prev[i] + unzigzag(delta[i]) : prev[i] ^ delta[i];
+    }
+}
+
+#if defined(MINI_ROS_HAS_SSE2)
+size_t forwardSse2(const uint64_t* cur, const uint64_t* prev, uint64_t* out, size_t n, bool arithmetic) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i));
+        __m128i r;
+        if (arithmetic) {
+            __m128i d = _mm_sub_epi64(c, p);
+            // No 64-bit arithmetic shift in SSE2: the sign mask is 0 - (d >> 63)
+            __m128i sign = _mm_sub_epi64(zero, _mm_srli_epi64(d, 63));
+            r = _mm_xor_si128(_mm_slli_epi64(d, 1), sign);
+        } else {
+            r = _mm_xor_si128(c, p);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+    }
+    return i;
+}
+
+size_t inverseSse2(const uint64_t* delta, const uint64_t* prev, uint64_t* out, size_t n, bool arithmetic) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi64x(1);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i z = _mm_loadu_si128(reinterpret_cast<const __m128i*>(delta + i));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i));
+        __m128i r;
+        if (arithmetic) {
+            __m128i sign = _mm_sub_epi64(zero, _mm_and_si128(z, one));
+            r = _mm_add_epi64(p, _mm_xor_si128(_mm_srli_epi64(z, 1), sign));
+        } else {
+            r = _mm_xor_si128(z, p);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+    }
+    return i;
+}
+#endif
+
+#if defined(MINI_ROS_HAS_AVX2)
+MINI_ROS_TARGET_AVX2
+size_t forwardAvx2(const uint64_t* cur, const uint64_t* prev, uint64_t* out, size_t n, bool arithmetic) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + i));
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + i));
+        __m256i r;
+        if (arithmetic) {
+            __m256i d = _mm256_sub_epi64(c, p);
+            __m256i sign = _mm256_sub_epi64(zero, _mm256_srli_epi64(d, 63));
+            r = _mm256_xor_si256(_mm256_slli_epi64(d, 1), sign);
+        } else {
+            r = _mm256_xor_si256(c, p);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+    }
+    return i;
+}
+
+MINI_ROS_TARGET_AVX2
+size_t inverseAvx2(const uint64_t* delta, const uint64_t* prev, uint64_t* out, size_t n, bool arithmetic) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i z = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(delta + i));
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + i));
+        __m256i r;
+        if (arithmetic) {
+            __m256i sign = _mm256_sub_epi64(zero, _mm256_and_si256(z, one));
+            r = _mm256_add_epi64(p, _mm256_xor_si256(_mm256_srli_epi64(z, 1), sign));
+        } else {
+            r = _mm256_xor_si256(z, p);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+    }
+    return i;
+}
+#endif
+
+// Length of the run of zero words starting at `begin`
+size_t zeroRunScalar(const uint64_t* words, size_t begin, size_t n) {
+    size_t i = begin;
+    while (i < n && words[i] == 0) ++i;
+    return i - begin;
+}
+
+#if defined(MINI_ROS_HAS_SSE2)
+size_t zeroRunSse2(const uint64_t* words, size_t begin, size_t n) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = begin;
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xFFFF) break;
+    }
+    return i - begin + zeroRunScalar(words, i, n);
+}
+#endif
+
+#if defined(MINI_ROS_HAS_AVX2)
+MINI_ROS_TARGET_AVX2
+size_t zeroRunAvx2(const uint64_t* words, size_t begin, size_t n) {
+    size_t i = begin;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        if (!_mm256_testz_si256(v, v)) break;
+    }
+    return i - begin + zeroRunScalar(words, i, n);
+}
+#endif
+
+size_t zeroRun(const uint64_t* words, size_t begin, size_t n) {
+    switch (simd()) {
+#if defined(MINI_ROS_HAS_AVX2)
+    case SimdLevel::Avx2:
+        return zeroRunAvx2(words, begin, n);
+#endif
+#if defined(MINI_ROS_HAS_SSE2)
+    case SimdLevel::Avx: // No AVX-only path
+    case SimdLevel::Sse2:
+        return zeroRunSse2(words, begin, n);
+#endif
+    default:
+        return zeroRunScalar(words, begin, n);
+    }
+}
+
+void forwardTransform(const uint64_t* cur, const uint64_t* prev, uint64_t* out, size_t n, bool arithmetic) {
+    size_t done = 0;
+    switch (simd()) {
+#if defined(MINI_ROS_HAS_AVX2)
+    case SimdLevel::Avx2:
+        done = forwardAvx2(cur, prev, out, n, arithmetic);
+        break;
+#endif
+#if defined(MINI_ROS_HAS_SSE2)
+    case SimdLevel::Avx: // No AVX-only path
+    case SimdLevel::Sse2:
+        done = forwardSse2(cur, prev, out, n, arithmetic);
+        break;
+#endif
+    default:
+        break;
+    }
+    forwardScalar(cur, prev, out, done, n, arithmetic);
+}
+
+void inverseTransform(const uint64_t* delta, const uint64_t* prev, uint64_t* out, size_t n, bool arithmetic) {
+    size_t done = 0;
+    switch (simd()) {
+#if defined(MINI_ROS_HAS_AVX2)
+    case SimdLevel::Avx2:
+        done = inverseAvx2(delta, prev, out, n, arithmetic);
+        break;
+#endif
+#if defined(MINI_ROS_HAS_SSE2)
+    case SimdLevel::Avx: // No AVX-only path
+    case SimdLevel::Sse2:
+        done = inverseSse2(delta, prev, out, n, arithmetic);
+        break;
+#endif
+    default:
+        break;
+    }
+    inverseScalar(delta, prev, out, done, n, arithmetic);
+}
+
+// --- body coding ---
+
+// Unchanged words (0) are collapsed into runs: a 0x00 byte followed by
+// varint(run - 1). Any other word is a plain varint, whose first byte is
+// never 0x00, so the two cannot be confused.
+void packWords(const std::vector<uint64_t>& words, std::vector<uint8_t>& out) {
+    size_t n = words.size();
+    for (size_t i = 0; i < n;) {
+        if (words[i] == 0) {
+            size_t run = zeroRun(words.data(), i, n);
+            out.push_back(0);
+            putVarint(out, run - 1);
+            i += run;
+        } else {
+            putVarint(out, words[i]);
+            ++i;
+        }
+    }
+}
+
+bool unpackWords(const uint8_t* p, const uint8_t* end, std::vector<uint64_t>& words) {
+    size_t n = words.size();
+    size_t i = 0;
+    while (i < n && p < end) {
+        uint64_t value;
+        if (*p == 0) {
+            ++p;
+            if (!getVarint(p, end, value) || value >= n - i) return false;
+            std::memset(words.data() + i, 0, (value + 1) * sizeof(uint64_t));
+            i += value + 1;
+        } else {
+            if (!getVarint(p, end, value)) return false;
+            words[i++] = value;
+        }
+    }
+    return i == n && p == end;
+}
+
+// --- helpers ---
+
+void toWords(const uint8_t* data, size_t size, std::vector<uint64_t>& words) {
+    words.assign((size + 7) / 8, 0); // Zero-padded tail
+    if (size) std::memcpy(words.data(), data, size);
+}
+
+// Fast 32-bit checksum of the reconstructed payload (not cryptographic)
+uint32_t checksumWords(const std::vector<uint64_t>& words, size_t size) {
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ size;
+    for (uint64_t w : words) {
+        h = (h ^ w) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+void putChecksum(std::vector<uint8_t>& out, uint32_t checksum) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(checksum >> (8 * i)));
+}
+
+bool getChecksum(const uint8_t*& p, const uint8_t* end, uint32_t& checksum) {
+    if (end - p < 4) return false;
+    checksum = 0;
+    for (int i = 0; i < 4; ++i) checksum |= static_cast<uint32_t>(p[i]) << (8 * i);
+    p += 4;
+    return true;
+}
+
+} // namespace
+
+DeltaEncoder::DeltaEncoder(DeltaCodecOptions options) : options_(options) {}
+
+void DeltaEncoder::encode(const uint8_t* data, size_t size, std::vector<uint8_t>& frame) {
+    toWords(data, size, current_);
+    const bool arithmetic = options_.mode == DeltaMode::Arithmetic;
+    uint8_t flags = (arithmetic ? kFlagArithmetic : 0) | (options_.checksum ? kFlagChecksum : 0);
+    uint32_t checksum = options_.checksum ? checksumWords(current_, size) : 0;
+
+    bool keyframe = !havePrevious_ || size != previousSize_ || keyframeRequested_ ||
+                    (options_.keyframeInterval != 0 && sinceKeyframe_ >= options_.keyframeInterval);
+
+    frame.clear();
+    if (!keyframe) {
+        delta_.resize(current_.size());
+        forwardTransform(current_.data(), previous_.data(), delta_.data(), current_.size(), arithmetic);
+        frame.push_back(flags);
+        frame.push_back(sequence_);
+        if (options_.checksum) putChecksum(frame, checksum);
+        packWords(delta_, frame);
+        // Fall back to a keyframe when the delta does not pay off
+        size_t keyframeSize = 2 + varintLength(size) + (options_.checksum ? 4 : 0) + size;
+        if (frame.size() >= keyframeSize) {
+            keyframe = true;
+            frame.clear();
+        }
+    }
+    if (keyframe) {
+        frame.push_back(flags | kFlagKeyframe);
+        frame.push_back(sequence_);
+        putVarint(frame, size);
+        if (options_.checksum) putChecksum(frame, checksum);
+        frame.insert(frame.end(), data, data + size);
+        sinceKeyframe_ = 0;
+        keyframeRequested_ = false;
+        stats_.keyframes++;
+    } else {
+        stats_.deltas++;
+    }
+    sinceKeyframe_++;
+
+    previous_.swap(current_);
+    previousSize_ = size;
+    havePrevious_ = true;
+    sequence_++;
+    stats_.rawBytes += size;
+    stats_.encodedBytes += frame.size();
+}
+
+bool DeltaDecoder::decode(const uint8_t* frame, size_t size, std::vector<uint8_t>& payload) {
+    const uint8_t* p = frame;
+    const uint8_t* end = frame + size;
+    if (size < 2 || (frame[0] & ~kKnownFlags)) return fail();
+    uint8_t flags = *p++;
+    uint8_t sequence = *p++;
+    const bool arithmetic = flags & kFlagArithmetic;
+
+    size_t payloadSize;
+    uint32_t checksum = 0;
+    if (flags & kFlagKeyframe) {
+        uint64_t declared;
+        if (!getVarint(p, end, declared)) return fail();
+        if ((flags & kFlagChecksum) && !getChecksum(p, end, checksum)) return fail();
+        if (static_cast<uint64_t>(end - p) != declared) return fail();
+        payloadSize = static_cast<size_t>(declared);
+        toWords(p, payloadSize, current_);
+    } else {
+        // A delta needs the frame right before it
+        if (!havePrevious_ || sequence != static_cast<uint8_t>(sequence_ + 1)) return fail();
+        if ((flags & kFlagChecksum) && !getChecksum(p, end, checksum)) return fail();
+        payloadSize = previousSize_;
+        delta_.resize(previous_.size());
+        if (!unpackWords(p, end, delta_)) return fail();
+        current_.resize(previous_.size());
+        inverseTransform(delta_.data(), previous_.data(), current_.data(), current_.size(), arithmetic);
+    }
+
+    // Reconstruction check
+    if ((flags & kFlagChecksum) && checksumWords(current_, payloadSize) != checksum) return fail();
+
+    previous_.swap(current_);
+    previousSize_ = payloadSize;
+    havePrevious_ = true;
+    sequence_ = sequence;
+
+    payload.resize(payloadSize);
+    if (payloadSize) std::memcpy(payload.data(), previous_.data(), payloadSize);
+    return true;
+}
+
+bool DeltaDecoder::fail() {
+    havePrevious_ = false; // Wait for the next keyframe
+    failures_++;
+    return false;
+}
+
+void appendRecord(std::vector<uint8_t>& out, const std::vector<uint8_t>& frame) {
+    putVarint(out, frame.size());
+    out.insert(out.end(), frame.begin(), frame.end());
+}
+
+bool readRecord(const std::vector<uint8_t>& in, size_t& offset, std::vector<uint8_t>& frame) {
+    if (offset >= in.size()) return false;
+    const uint8_t* p = in.data() + offset;
+    const uint8_t* end = in.data() + in.size();
+    uint64_t length;
+    if (!getVarint(p, end, length) || length > static_cast<uint64_t>(end - p)) return false;
+    frame.assign(p, p + length);
+    offset = static_cast<size_t>(p + length - in.data());
+    return true;
+}
+
+} // namespace mini_ros
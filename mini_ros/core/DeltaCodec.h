@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mini_ros {
+
+// How a delta frame encodes each 64-bit word against the previous message
+enum class DeltaMode : uint8_t {
+    Xor,        // cur ^ prev: best for floating point and bit fields
+    Arithmetic, // zigzag(cur - prev): best for counters and fixed-point values
+};
+
+struct DeltaCodecOptions {
+    DeltaMode mode = DeltaMode::Xor;
+    // Frames between keyframes (0 = only when required). A keyframe lets a
+    // late subscriber or a reader seeking in a recording resynchronize.
+    uint32_t keyframeInterval = 64;
+    // Adds a 4-byte checksum of the reconstructed payload to every frame, so
+    // a decoder detects a lost or reordered frame instead of drifting silently
+    bool checksum = true;
+};
+
+struct DeltaCodecStats {
+    uint64_t keyframes = 0;
+    uint64_t deltas = 0;
+    uint64_t rawBytes = 0;     // Serialized payload bytes
+    uint64_t encodedBytes = 0; // Frame bytes produced
+
+    double ratio() const { return encodedBytes ? static_cast<double>(rawBytes) / encodedBytes : 0.0; }
+};
+
+// Keyframe/delta encoding for slowly changing, high-rate state streams. Sits
+// on top of message serialization: feed it the output of serialize() and send
+// or store the frame instead. Frames are self-contained byte strings, so the
+// same frames work for a transport and for a recording (see appendRecord()).
+//
+// The payload is treated as little-endian 64-bit words. A delta frame stores
+// each word's XOR or zigzag difference to the previous message as a varint,
+// with runs of unchanged words collapsed; word transforms use SSE2/AVX2 when
+// available. A keyframe is sent whenever a delta would not be smaller, the
+// payload size changes, the interval elapses, or one is requested.
+class DeltaEncoder {
+public:
+    explicit DeltaEncoder(DeltaCodecOptions options = DeltaCodecOptions());
+
+    // Encodes one serialized message into `frame` (replacing its contents)
+    void encode(const uint8_t* data, size_t size, std::vector<uint8_t>& frame);
+
+    void encode(const std::vector<uint8_t>& payload, std::vector<uint8_t>& frame) {
+        encode(payload.data(), payload.size(), frame);
+    }
+
+    template<class MsgT>
+    void encodeMessage(const MsgT& msg, std::vector<uint8_t>& frame) {
+        encode(msg.serialize(), frame);
+    }
+
+    // Forces the next frame to be a keyframe (e.g. a subscriber joined or reported loss)
+    void requestKeyframe() { keyframeRequested_ = true; }
+
+    const DeltaCodecStats& getStats() const { return stats_; }
+
+private:
+    DeltaCodecOptions options_;
+    std::vector<uint64_t> previous_; // Previous payload as zero-padded words
+    std::vector<uint64_t> current_;
+    std::vector<uint64_t> delta_;
+    size_t previousSize_ = 0;
+    bool havePrevious_ = false;
+    bool keyframeRequested_ = false;
+    uint32_t sinceKeyframe_ = 0;
+    uint8_t sequence_ = 0;
+    DeltaCodecStats stats_;
+};
+
+// Reverses DeltaEncoder. Deltas only apply on top of the frame right before
+// them; after a gap, a checksum mismatch or a corrupt frame, decode() returns
+// false until the next keyframe.
+class DeltaDecoder {
+public:
+    // Reconstructs the serialized message into `payload`. Returns false if the
+    // frame cannot be applied; `payload` is then unspecified.
+    bool decode(const uint8_t* frame, size_t size, std::vector<uint8_t>& payload);
+
+    bool decode(const std::vector<uint8_t>& frame, std::vector<uint8_t>& payload) {
+        return decode(frame.data(), frame.size(), payload);
+    }
+
+    template<class MsgT>
+    bool decodeMessage(const std::vector<uint8_t>& frame, MsgT& msg) {
+        if (!decode(frame, payload_)) return false;
+        msg.deserialize(payload_);
+        return true;
+    }
+
+    // False while waiting for a keyframe
+    bool synchronized() const { return havePrevious_; }
+    uint64_t getFailureCount() const { return failures_; }
+
+private:
+    bool fail();
+
+    std::vector<uint64_t> previous_;
+    std::vector<uint64_t> current_;
+    std::vector<uint64_t> delta_;
+    std::vector<uint8_t> payload_; // Reused by decodeMessage()
+    size_t previousSize_ = 0;
+    bool havePrevious_ = false;
+    uint8_t sequence_ = 0;
+    uint64_t failures_ = 0;
+};
+
+// Length-prefixed framing for storing frames back to back, e.g. in a recording file
+void appendRecord(std::vector<uint8_t>& out, const std::vector<uint8_t>& frame);
+// Reads the record at `offset` and advances it; false at the end or on truncation
+bool readRecord(const std::vector<uint8_t>& in, size_t& offset, std::vector<uint8_t>& frame);
+
+} // namespace mini_ros
@@ -10,17 +10,24 @@ namespace mini_ros {
 
 // Base interface for all messages
 struct IMessage {
-    // Timestamp for performance tracking
+    // Timestamp for performance tracking, set by Publisher::publish from the core's clock
     std::chrono::time_point<std::chrono::high_resolution_clock> timestamp;
 
-    IMessage() : timestamp(std::chrono::high_resolution_clock::now()) {}
+    IMessage() = default;
     virtual ~IMessage() = default;
+
+    // Approximate memory held by this message, including heap payloads.
+    // Used for per-topic memory accounting and byte budgets; message types
+    // with heap data should override it.
+    virtual size_t byteSize() const { return sizeof(IMessage); }
 };
 
 // Example standard message
 struct StringMessage : public IMessage {
     std::string data;
 
+    size_t byteSize() const override { return sizeof(*this) + data.capacity(); }
+
     // Simple "serialization" for demo
     // In a real system, this would be more robust (e.g., Protobuf, flatbuffers)
     std::vector<uint8_t> serialize() const {
@@ -38,6 +45,8 @@ struct StringMessage : public IMessage {
 struct Int64Message : public IMessage {
     int64_t data;
 
+    size_t byteSize() const override { return sizeof(*this); }
+
     std::vector<uint8_t> serialize() const {
         std::vector<uint8_t> buffer(sizeof(data));
         std::memcpy(buffer.data(), &data, sizeof(data));
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mini_ros {
+
+// Reported when publishers and subscribers on a topic find or lose each other
+struct MatchStatus {
+    std::string topic;
+    size_t currentCount; // Peers matched after this event
+    int change;          // > 0 when peers matched, < 0 when they went away
+};
+
+// Peer count and matched/unmatched callbacks for one publisher or subscriber.
+// The count is updated by the core under its topic lock; callbacks are
+// invoked afterwards, outside the lock, so they may publish or subscribe.
+class MatchTracker {
+public:
+    using CallbackT = std::function<void(const MatchStatus&)>;
+
+    size_t count() const { return count_.load(std::memory_order_acquire); }
+
+    void onMatched(CallbackT callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        matched_.push_back(std::move(callback));
+    }
+
+    void onUnmatched(CallbackT callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unmatched_.push_back(std::move(callback));
+    }
+
+    // Returns the new count
+    size_t apply(int change) {
+        // Unsigned wrap-around makes negative changes work
+        auto delta = static_cast<size_t>(change);
+        return count_.fetch_add(delta, std::memory_order_acq_rel) + delta;
+    }
+
+    void notify(const MatchStatus& status) const {
+        std::vector<CallbackT> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callbacks = status.change > 0 ? matched_ : unmatched_;
+        }
+        for (auto& callback : callbacks) {
+            callback(status);
+        }
+    }
+
+private:
+    std::atomic<size_t> count_{0};
+    mutable std::mutex mutex_;
+    std::vector<CallbackT> matched_;
+    std::vector<CallbackT> unmatched_;
+};
+
+} // namespace mini_ros
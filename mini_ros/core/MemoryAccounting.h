@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace mini_ros {
+
+// What to do when queuing a message would exceed a byte budget
+enum class OverflowPolicy {
+    DropOldest, // Evict queued messages, oldest first, to make room
+    DropNewest, // Reject the incoming message
+};
+
+// Snapshot of queued-message memory for a subscriber or a whole topic
+struct MemoryStats {
+    size_t inFlightBytes = 0;
+    size_t peakBytes = 0;
+    size_t inFlightMessages = 0;
+    size_t peakMessages = 0;
+    size_t droppedMessages = 0;
+    size_t byteBudget = 0; // 0 = unlimited
+};
+
+// Lock-free counters for bytes and messages sitting in subscriber queues,
+// plus an optional byte budget. Owned per topic by the core and per
+// subscriber.
+class MemoryCounter {
+public:
+    void setBudget(size_t maxBytes, OverflowPolicy policy) {
+        policy_.store(policy, std::memory_order_relaxed);
+        budget_.store(maxBytes, std::memory_order_release);
+    }
+
+    OverflowPolicy policy() const { return policy_.load(std::memory_order_relaxed); }
+
+    bool wouldExceed(size_t bytes) const {
+        size_t budget = budget_.load(std::memory_order_acquire);
+        return budget != 0 && bytes_.load(std::memory_order_acquire) + bytes > budget;
+    }
+
+    void add(size_t bytes) {
+        raiseTo(peakBytes_, bytes_.fetch_add(bytes, std::memory_order_acq_rel) + bytes);
+        raiseTo(peakMessages_, messages_.fetch_add(1, std::memory_order_acq_rel) + 1);
+    }
+
+    void remove(size_t bytes) {
+        bytes_.fetch_sub(bytes, std::memory_order_acq_rel);
+        messages_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void recordDrop() { dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+    MemoryStats snapshot() const {
+        MemoryStats stats;
+        stats.inFlightBytes = bytes_.load(std::memory_order_acquire);
+        stats.peakBytes = peakBytes_.load(std::memory_order_relaxed);
+        stats.inFlightMessages = messages_.load(std::memory_order_acquire);
+        stats.peakMessages = peakMessages_.load(std::memory_order_relaxed);
+        stats.droppedMessages = dropped_.load(std::memory_order_relaxed);
+        stats.byteBudget = budget_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static void raiseTo(std::atomic<size_t>& peak, size_t value) {
+        size_t current = peak.load(std::memory_order_relaxed);
+        while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::atomic<size_t> bytes_{0};
+    std::atomic<size_t> peakBytes_{0};
+    std::atomic<size_t> messages_{0};
+    std::atomic<size_t> peakMessages_{0};
+    std::atomic<size_t> dropped_{0};
+    std::atomic<size_t> budget_{0};
+    std::atomic<OverflowPolicy> policy_{OverflowPolicy::DropOldest};
+};
+
+// One published message on its topic's counter. Every subscriber queue entry
+// for the message shares the charge, so the topic counts the message once
+// however many subscribers it fans out to; the bytes are released when the
+// last entry is consumed or evicted.
+class TopicCharge {
+public:
+    TopicCharge(std::shared_ptr<MemoryCounter> counter, size_t bytes, uint64_t sequence)
+        : counter_(std::move(counter)), bytes_(bytes), sequence_(sequence) {
+        counter_->add(bytes_);
+    }
+
+    ~TopicCharge() { counter_->remove(bytes_); }
+
+    TopicCharge(const TopicCharge&) = delete;
+    TopicCharge& operator=(const TopicCharge&) = delete;
+
+    // Publish order on the topic; the core evicts the lowest first
+    uint64_t sequence() const { return sequence_; }
+
+private:
+    std::shared_ptr<MemoryCounter> counter_;
+    size_t bytes_;
+    uint64_t sequence_;
+};
+
+} // namespace mini_ros
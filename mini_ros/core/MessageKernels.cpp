@@ -0,0 +1,384 @@
+#include "MessageKernels.h"
+#include "../common/Simd.h"
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace mini_ros {
+namespace kernels {
+
+namespace {
+
+// --- transform ---
+
+// Each vector path processes whole blocks and returns how many points it handled;
+// the scalar loop finishes the tail.
+void transformScalar(const float* x, const float* y, const float* z,
+                     float* ox, float* oy, float* oz,
+                     size_t begin, size_t end, const Transform3f& tf) {
+    const float* r = tf.rotation;
+    const float* t = tf.translation;
+    for (size_t i = begin; i < end; ++i) {
+        ox[i] = r[0] * x[i] + r[1] * y[i] + r[2] * z[i] + t[0];
+        oy[i] = r[3] * x[i] + r[4] * y[i] + r[5] * z[i] + t[1];
+        oz[i] = r[6] * x[i] + r[7] * y[i] + r[8] * z[i] + t[2];
+    }
+}
+
+#if defined(MINI_ROS_HAS_SSE2)
+size_t transformSse2(const float* x, const float* y, const float* z,
+                     float* ox, float* oy, float* oz,
+                     size_t n, const Transform3f& tf) {
+    __m128 r[9];
+    for (int k = 0; k < 9; ++k) r[k] = _mm_set1_ps(tf.rotation[k]);
+    __m128 t0 = _mm_set1_ps(tf.translation[0]);
+    __m128 t1 = _mm_set1_ps(tf.translation[1]);
+    __m128 t2 = _mm_set1_ps(tf.translation[2]);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 vx = _mm_load_ps(x + i);
+        __m128 vy = _mm_load_ps(y + i);
+        __m128 vz = _mm_load_ps(z + i);
+        _mm_store_ps(ox + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0], vx), _mm_mul_ps(r[1], vy)),
+                                        _mm_add_ps(_mm_mul_ps(r[2], vz), t0)));
+        _mm_store_ps(oy + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[3], vx), _mm_mul_ps(r[4], vy)),
+                                        _mm_add_ps(_mm_mul_ps(r[5], vz), t1)));
+        _mm_store_ps(oz + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[6], vx), _mm_mul_ps(r[7], vy)),
+                                        _mm_add_ps(_mm_mul_ps(r[8], vz), t2)));
+    }
+    return i;
+}
+#endif
+
+#if defined(MINI_ROS_HAS_AVX)
+MINI_ROS_TARGET_AVX
+size_t transformAvx(const float* x, const float* y, const float* z,
+                    float* ox, float* oy, float* oz,
+                    size_t n, const Transform3f& tf) {
+    __m256 r[9];
+    for (int k = 0; k < 9; ++k) r[k] = _mm256_set1_ps(tf.rotation[k]);
+    __m256 t0 = _mm256_set1_ps(tf.translation[0]);
+    __m256 t1 = _mm256_set1_ps(tf.translation[1]);
+    __m256 t2 = _mm256_set1_ps(tf.translation[2]);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 vx = _mm256_load_ps(x + i);
+        __m256 vy = _mm256_load_ps(y + i);
+        __m256 vz = _mm256_load_ps(z + i);
+        _mm256_store_ps(ox + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[0], vx), _mm256_mul_ps(r[1], vy)),
+                                              _mm256_add_ps(_mm256_mul_ps(r[2], vz), t0)));
+        _mm256_store_ps(oy + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[3], vx), _mm256_mul_ps(r[4], vy)),
+                                              _mm256_add_ps(_mm256_mul_ps(r[5], vz), t1)));
+        _mm256_store_ps(oz + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[6], vx), _mm256_mul_ps(r[7], vy)),
+                                              _mm256_add_ps(_mm256_mul_ps(r[8], vz), t2)));
+    }
+    return i;
+}
+#endif
+
+// --- crop ---
+
+inline bool insideBox(float px, float py, float pz, const float* lo, const float* hi) {
+    return px >= lo[0] && px <= hi[0] && py >= lo[1] && py <= hi[1] && pz >= lo[2] && pz <= hi[2];
+}
+
+inline void copyPoint(const PointCloudMessage& in, size_t i, PointCloudMessage& out, size_t j) {
+    out.x[j] = in.x[i];
+    out.y[j] = in.y[i];
+    out.z[j] = in.z[i];
+    out.intensity[j] = in.intensity[i];
+}
+
+#if defined(MINI_ROS_HAS_SSE2)
+size_t cropSse2(const PointCloudMessage& in, const float* lo, const float* hi,
+                PointCloudMessage& out, size_t& written) {
+    const size_t n = in.size();
+    __m128 lx = _mm_set1_ps(lo[0]), ly = _mm_set1_ps(lo[1]), lz = _mm_set1_ps(lo[2]);
+    __m128 hx = _mm_set1_ps(hi[0]), hy = _mm_set1_ps(hi[1]), hz = _mm_set1_ps(hi[2]);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 vx = _mm_load_ps(in.x.data() + i);
+        __m128 vy = _mm_load_ps(in.y.data() + i);
+        __m128 vz = _mm_load_ps(in.z.data() + i);
+        __m128 m = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(vx, lx), _mm_cmple_ps(vx, hx)),
+                              _mm_and_ps(_mm_cmpge_ps(vy, ly), _mm_cmple_ps(vy, hy)));
+        m = _mm_and_ps(m, _mm_and_ps(_mm_cmpge_ps(vz, lz), _mm_cmple_ps(vz, hz)));
+        int bits = _mm_movemask_ps(m);
+        for (int k = 0; bits; ++k, bits >>= 1) {
+            if (bits & 1) copyPoint(in, i + k, out, written++);
+        }
+    }
+    return i;
+}
+#endif
+
+#if defined(MINI_ROS_HAS_AVX)
+MINI_ROS_TARGET_AVX
+size_t cropAvx(const PointCloudMessage& in, const float* lo, const float* hi,
+               PointCloudMessage& out, size_t& written) {
+    const size_t n = in.size();
+    __m256 lx = _mm256_set1_ps(lo[0]), ly = _mm256_set1_ps(lo[1]), lz = _mm256_set1_ps(lo[2]);
+    __m256 hx = _mm256_set1_ps(hi[0]), hy = _mm256_set1_ps(hi[1]), hz = _mm256_set1_ps(hi[2]);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 vx = _mm256_load_ps(in.x.data() + i);
+        __m256 vy = _mm256_load_ps(in.y.data() + i);
+        __m256 vz = _mm256_load_ps(in.z.data() + i);
+        __m256 m = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(vx, lx, _CMP_GE_OQ), _mm256_cmp_ps(vx, hx, _CMP_LE_OQ)),
+                                 _mm256_and_ps(_mm256_cmp_ps(vy, ly, _CMP_GE_OQ), _mm256_cmp_ps(vy, hy, _CMP_LE_OQ)));
+        m = _mm256_and_ps(m, _mm256_and_ps(_mm256_cmp_ps(vz, lz, _CMP_GE_OQ), _mm256_cmp_ps(vz, hz, _CMP_LE_OQ)));
+        int bits = _mm256_movemask_ps(m);
+        for (int k = 0; bits; ++k, bits >>= 1) {
+            if (bits & 1) copyPoint(in, i + k, out, written++);
+        }
+    }
+    return i;
+}
+#endif
+
+// --- pixel formats ---
+
+// Byte offsets of the red/green/blue/alpha channels within a pixel (-1 if absent)
+struct ChannelLayout {
+    int r, g, b, a;
+};
+
+ChannelLayout layoutOf(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::MONO8: return {0, 0, 0, -1};
+        case PixelFormat::RGB8: return {0, 1, 2, -1};
+        case PixelFormat::BGR8: return {2, 1, 0, -1};
+        case PixelFormat::RGBA8: return {0, 1, 2, 3};
+        case PixelFormat::BGRA8: return {2, 1, 0, 3};
+    }
+    return {0, 0, 0, -1};
+}
+
+// BT.601 luma in 8.8 fixed point: (77 R + 150 G + 29 B) >> 8
+inline uint8_t luma(uint32_t r, uint32_t g, uint32_t b) {
+    return static_cast<uint8_t>((77 * r + 150 * g + 29 * b) >> 8);
+}
+
+void convertRowScalar(const uint8_t* src, PixelFormat from, uint8_t* dst, PixelFormat to,
+                      size_t begin, size_t end) {
+    const ChannelLayout in = layoutOf(from);
+    const ChannelLayout out = layoutOf(to);
+    const size_t inBpp = bytesPerPixel(from);
+    const size_t outBpp = bytesPerPixel(to);
+    for (size_t px = begin; px < end; ++px) {
+        const uint8_t* s = src + px * inBpp;
+        uint8_t* d = dst + px * outBpp;
+        if (to == PixelFormat::MONO8) {
+            d[0] = (from == PixelFormat::MONO8) ? s[0] : luma(s[in.r], s[in.g], s[in.b]);
+            continue;
+        }
+        d[out.r] = s[in.r];
+        d[out.g] = s[in.g];
+        d[out.b] = s[in.b];
+        if (out.a >= 0) d[out.a] = (in.a >= 0) ? s[in.a] : 0xFF;
+    }
+}
+
+#if defined(MINI_ROS_HAS_SSE2)
+// 4-channel to MONO8, 4 pixels per iteration. `redFirst` selects RGBA vs BGRA.
+size_t lumaFrom4ChannelSse2(const uint8_t* src, uint8_t* dst, size_t n, bool redFirst) {
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i wR = _mm_set1_epi32(77), wG = _mm_set1_epi32(150), wB = _mm_set1_epi32(29);
+    const int rShift = redFirst ? 0 : 16;
+    const int bShift = redFirst ? 16 : 0;
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i r = _mm_and_si128(_mm_srl_epi32(p, _mm_cvtsi32_si128(rShift)), mask);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(p, 8), mask);
+        __m128i b = _mm_and_si128(_mm_srl_epi32(p, _mm_cvtsi32_si128(bShift)), mask);
+        // Products fit in 16 bits, so the low-half multiply is exact
+        __m128i y = _mm_add_epi32(_mm_add_epi32(_mm_mullo_epi16(r, wR), _mm_mullo_epi16(g, wG)),
+                                  _mm_mullo_epi16(b, wB));
+        y = _mm_srli_epi32(y, 8);
+        y = _mm_packs_epi32(y, y);
+        y = _mm_packus_epi16(y, y);
+        int packed = _mm_cvtsi128_si32(y);
+        std::memcpy(dst + i, &packed, 4);
+    }
+    return i;
+}
+
+// RGBA8 <-> BGRA8 (and RGBA8 -> RGBA8 copies), 4 pixels per iteration
+size_t swapRedBlueSse2(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m128i keep = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const __m128i low = _mm_set1_epi32(0xFF);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i swapped = _mm_or_si128(_mm_and_si128(p, keep),
+                                       _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 16), low),
+                                                    _mm_slli_epi32(_mm_and_si128(p, low), 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), swapped);
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+const char* simdLevel() {
+    switch (simd()) {
+        case SimdLevel::Avx2:
+        case SimdLevel::Avx: return "avx";
+        case SimdLevel::Sse2: return "sse2";
+        case SimdLevel::Scalar: break;
+    }
+    return "scalar";
+}
+
+bool transform(const PointCloudMessage& in, const Transform3f& tf, PointCloudMessage& out) {
+    if (!in.consistent()) return false;
+    const size_t n = in.size();
+    out.frameId = in.frameId;
+    out.resize(n);
+    out.intensity = in.intensity;
+
+    size_t done = 0;
+    switch (simd()) {
+#if defined(MINI_ROS_HAS_AVX)
+        case SimdLevel::Avx2:
+        case SimdLevel::Avx:
+            done = transformAvx(in.x.data(), in.y.data(), in.z.data(),
+                                out.x.data(), out.y.data(), out.z.data(), n, tf);
+            break;
+#endif
+#if defined(MINI_ROS_HAS_SSE2)
+        case SimdLevel::Sse2:
+            done = transformSse2(in.x.data(), in.y.data(), in.z.data(),
+                                 out.x.data(), out.y.data(), out.z.data(), n, tf);
+            break;
+#endif
+        default:
+            break;
+    }
+    transformScalar(in.x.data(), in.y.data(), in.z.data(),
+                    out.x.data(), out.y.data(), out.z.data(), done, n, tf);
+    return true;
+}
+
+bool cropBox(const PointCloudMessage& in, const float minCorner[3], const float maxCorner[3],
+             PointCloudMessage& out) {
+    if (!in.consistent()) return false;
+    const size_t n = in.size();
+    out.frameId = in.frameId;
+    out.resize(n); // Upper bound; shrunk below
+
+    size_t written = 0;
+    size_t done = 0;
+    switch (simd()) {
+#if defined(MINI_ROS_HAS_AVX)
+        case SimdLevel::Avx2:
+        case SimdLevel::Avx:
+            done = cropAvx(in, minCorner, maxCorner, out, written);
+            break;
+#endif
+#if defined(MINI_ROS_HAS_SSE2)
+        case SimdLevel::Sse2:
+            done = cropSse2(in, minCorner, maxCorner, out, written);
+            break;
+#endif
+        default:
+            break;
+    }
+    for (size_t i = done; i < n; ++i) {
+        if (insideBox(in.x[i], in.y[i], in.z[i], minCorner, maxCorner)) {
+            copyPoint(in, i, out, written++);
+        }
+    }
+    out.resize(written);
+    return true;
+}
+
+bool voxelDownsample(const PointCloudMessage& in, float leafSize, PointCloudMessage& out) {
+    if (!in.consistent()) return false;
+    const size_t n = in.size();
+    out.frameId = in.frameId;
+    if (leafSize <= 0.0f) {
+        // Degenerate leaf: nothing to merge
+        out.x = in.x;
+        out.y = in.y;
+        out.z = in.z;
+        out.intensity = in.intensity;
+        return true;
+    }
+
+    // Accumulation is hash-bound rather than arithmetic-bound, so it stays scalar
+    struct Accumulator {
+        double x = 0.0, y = 0.0, z = 0.0, intensity = 0.0;
+        uint32_t count = 0;
+    };
+    const float inv = 1.0f / leafSize;
+    std::unordered_map<uint64_t, size_t> voxelIndex;
+    voxelIndex.reserve(n / 4 + 1);
+    std::vector<Accumulator> voxels;
+
+    for (size_t i = 0; i < n; ++i) {
+        // 21 bits per axis covers +/- 1M voxels
+        auto cell = [inv](float v) {
+            return static_cast<uint64_t>(static_cast<int64_t>(std::floor(v * inv)) & 0x1FFFFF);
+        };
+        uint64_t key = (cell(in.x[i]) << 42) | (cell(in.y[i]) << 21) | cell(in.z[i]);
+        auto result = voxelIndex.emplace(key, voxels.size());
+        if (result.second) voxels.emplace_back();
+        Accumulator& acc = voxels[result.first->second];
+        acc.x += in.x[i];
+        acc.y += in.y[i];
+        acc.z += in.z[i];
+        acc.intensity += in.intensity[i];
+        acc.count++;
+    }
+
+    out.resize(voxels.size());
+    for (size_t v = 0; v < voxels.size(); ++v) {
+        const Accumulator& acc = voxels[v];
+        out.x[v] = static_cast<float>(acc.x / acc.count);
+        out.y[v] = static_cast<float>(acc.y / acc.count);
+        out.z[v] = static_cast<float>(acc.z / acc.count);
+        out.intensity[v] = static_cast<float>(acc.intensity / acc.count);
+    }
+    return true;
+}
+
+bool convertPixelFormat(const ImageMessage& in, PixelFormat format, ImageMessage& out) {
+    if (!in.consistent() || bytesPerPixel(format) == 0) return false;
+
+    out.frameId = in.frameId;
+    out.allocate(in.width, in.height, format);
+
+    const bool fourToMono = format == PixelFormat::MONO8 &&
+        (in.format == PixelFormat::RGBA8 || in.format == PixelFormat::BGRA8);
+    const bool swapFour = (in.format == PixelFormat::RGBA8 && format == PixelFormat::BGRA8) ||
+                          (in.format == PixelFormat::BGRA8 && format == PixelFormat::RGBA8);
+
+    for (uint32_t row = 0; row < in.height; ++row) {
+        const uint8_t* src = in.data.data() + static_cast<size_t>(row) * in.step;
+        uint8_t* dst = out.data.data() + static_cast<size_t>(row) * out.step;
+        size_t done = 0;
+#if defined(MINI_ROS_HAS_SSE2)
+        if (fourToMono) {
+            done = lumaFrom4ChannelSse2(src, dst, in.width, in.format == PixelFormat::RGBA8);
+        } else if (swapFour) {
+            done = swapRedBlueSse2(src, dst, in.width);
+        }
+#else
+        (void)fourToMono;
+        (void)swapFour;
+#endif
+        convertRowScalar(src, in.format, dst, format, done, in.width);
+    }
+    return true;
+}
+
+} // namespace kernels
+} // namespace mini_ros
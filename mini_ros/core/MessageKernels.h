@@ -0,0 +1,44 @@
+#pragma once
+
+#include "StdMessages.h"
+
+namespace mini_ros {
+
+// Rigid transform: p' = R * p + t (row-major rotation)
+struct Transform3f {
+    float rotation[9] = {1.0f, 0.0f, 0.0f,
+                         0.0f, 1.0f, 0.0f,
+                         0.0f, 0.0f, 1.0f};
+    float translation[3] = {0.0f, 0.0f, 0.0f};
+};
+
+// Vectorized kernels for the standard large-payload messages. Each kernel
+// picks the widest instruction set available at runtime (AVX, then SSE2) and
+// falls back to scalar code elsewhere. `out` may not alias `in`. A kernel
+// returns false, leaving `out` untouched, for inconsistent input: a point
+// cloud whose field buffers differ in size, or an image whose step or buffer
+// is too small for its geometry (see consistent()).
+namespace kernels {
+
+// Which SIMD path the kernels dispatch to on this machine ("avx", "sse2" or "scalar")
+const char* simdLevel();
+
+// Applies `tf` to every point. Intensity and frame id are copied.
+bool transform(const PointCloudMessage& in, const Transform3f& tf, PointCloudMessage& out);
+
+// Keeps the points inside the axis-aligned box [minCorner, maxCorner] (inclusive)
+bool cropBox(const PointCloudMessage& in, const float minCorner[3], const float maxCorner[3],
+             PointCloudMessage& out);
+
+// Replaces the points in each cubic voxel of edge `leafSize` by their centroid
+// (intensity is averaged too). Output order follows first occurrence.
+bool voxelDownsample(const PointCloudMessage& in, float leafSize, PointCloudMessage& out);
+
+// Converts between any two pixel formats; color to MONO8 uses ITU-R BT.601
+// luma weights and added alpha channels are opaque. Also returns false for
+// an unknown target format.
+bool convertPixelFormat(const ImageMessage& in, PixelFormat format, ImageMessage& out);
+
+} // namespace kernels
+
+} // namespace mini_ros
@@ -1,8 +1,55 @@
 #include "MiniRosCore.h"
 #include "Node.h" // For Node::shutdown
+#include "StdMessages.h" // For ClockMessage
+#include "Publisher.h"
 
 namespace mini_ros {
 
+namespace {
+
+// Sets a SteppedClock from ClockMessages as soon as they are published,
+// without waiting for any node to spin
+class ClockSubscriber : public ISubscriber {
+public:
+    ClockSubscriber(const std::string& topic, std::shared_ptr<SteppedClock> clock)
+        : topicName_(topic), clock_(clock) {}
+
+    void spinOnce() override {}
+    std::string getTopicName() const override { return topicName_; }
+
+    void enqueueRaw(std::shared_ptr<IMessage> msg) override {
+        if (auto clockMsg = std::dynamic_pointer_cast<ClockMessage>(msg)) {
+            clock_->setTime(Clock::TimePoint(std::chrono::duration_cast<Clock::Duration>(
+                std::chrono::nanoseconds(clockMsg->nanoseconds))));
+        }
+    }
+
+    void enqueueRawBatch(const std::vector<std::shared_ptr<IMessage>>& msgs) override {
+        for (auto& msg : msgs) {
+            enqueueRaw(msg);
+        }
+    }
+
+    Statistics getStats() const override { return Statistics(); }
+    void setProfilingEnabled(bool) override {}
+    CallbackProfile getProfile() const override { return CallbackProfile(); }
+
+private:
+    std::string topicName_;
+    std::shared_ptr<SteppedClock> clock_;
+};
+
+} // namespace
+
+MiniRosCore::MiniRosCore() {
+    // Calibrate Stopwatch's timestamp source before any callback is timed
+    FastTimestamp::warmUp();
+}
+
+MiniRosCore::~MiniRosCore() {
+    shutdown();
+}
+
 void MiniRosCore::registerNode(Node* node) {
     std::lock_guard<std::mutex> lock(nodeMutex_);
     nodes_.push_back(node);
@@ -13,14 +60,169 @@ void MiniRosCore::unregisterNode(Node* node) {
     nodes_.erase(std::remove(nodes_.begin(), nodes_.end(), node), nodes_.end());
 }
 
-void MiniRosCore::registerPublisher(Publisher* pub, const std::string& topic) {
-    // We don't strictly need to register publishers in this model,
-    // but we could add logging or tracking here.
+struct MiniRosCore::PendingMatchEvents {
+    std::vector<std::pair<std::shared_ptr<Publisher>, MatchStatus>> publishers;
+    std::vector<std::pair<std::shared_ptr<ISubscriber>, MatchStatus>> subscribers;
+
+    void fire() {
+        for (auto& event : publishers) event.first->matchTracker().notify(event.second);
+        for (auto& event : subscribers) event.first->matchTracker().notify(event.second);
+    }
+};
+
+void MiniRosCore::unmatchSubscribersLocked(const std::string& topic, int removed, PendingMatchEvents& events) {
+    if (removed == 0) return;
+    for (auto& entry : topicPublishers_[topic]) {
+        if (auto pub = entry.pub.lock()) {
+            size_t count = pub->matchTracker().apply(-removed);
+            events.publishers.emplace_back(pub, MatchStatus{topic, count, -removed});
+        }
+    }
+}
+
+void MiniRosCore::registerPublisher(std::shared_ptr<Publisher> pub) {
+    const std::string& topic = pub->getTopicName();
+    PendingMatchEvents events;
+    {
+        std::lock_guard<std::mutex> lock(topicMutex_);
+        topicPublishers_[topic].push_back(PublisherEntry{pub.get(), pub});
+
+        int matched = 0;
+        for (auto& w_sub : topicSubscribers_[topic]) {
+            if (auto sub = w_sub.lock()) {
+                size_t count = sub->matchTracker().apply(+1);
+                events.subscribers.emplace_back(sub, MatchStatus{topic, count, +1});
+                matched++;
+            }
+        }
+        if (matched > 0) {
+            size_t count = pub->matchTracker().apply(matched);
+            events.publishers.emplace_back(pub, MatchStatus{topic, count, matched});
+        }
+    }
+    events.fire();
+}
+
+void MiniRosCore::unregisterPublisher(Publisher* pub) {
+    PendingMatchEvents events;
+    {
+        std::lock_guard<std::mutex> lock(topicMutex_);
+        auto it = topicPublishers_.find(pub->getTopicName());
+        if (it == topicPublishers_.end()) return;
+        auto& pubs = it->second;
+        auto entry = std::find_if(pubs.begin(), pubs.end(),
+            [pub](const PublisherEntry& e) { return e.raw == pub; });
+        if (entry == pubs.end()) return;
+        pubs.erase(entry);
+
+        for (auto& w_sub : topicSubscribers_[it->first]) {
+            if (auto sub = w_sub.lock()) {
+                size_t count = sub->matchTracker().apply(-1);
+                events.subscribers.emplace_back(sub, MatchStatus{it->first, count, -1});
+            }
+        }
+    }
+    events.fire();
 }
 
 void MiniRosCore::registerSubscriber(std::shared_ptr<ISubscriber> sub) {
+    const std::string topic = sub->getTopicName();
+    PendingMatchEvents events;
+    {
+        std::lock_guard<std::mutex> lock(topicMutex_);
+        topicSubscribers_[topic].push_back(sub);
+
+        int matched = 0;
+        for (auto& entry : topicPublishers_[topic]) {
+            if (auto pub = entry.pub.lock()) {
+                size_t count = pub->matchTracker().apply(+1);
+                events.publishers.emplace_back(pub, MatchStatus{topic, count, +1});
+                matched++;
+            }
+        }
+        if (matched > 0) {
+            size_t count = sub->matchTracker().apply(matched);
+            events.subscribers.emplace_back(sub, MatchStatus{topic, count, matched});
+        }
+    }
+    events.fire();
+}
+
+void MiniRosCore::unregisterSubscriber(ISubscriber* sub) {
+    const std::string topic = sub->getTopicName();
+    PendingMatchEvents events;
+    {
+        std::lock_guard<std::mutex> lock(topicMutex_);
+        auto it = topicSubscribers_.find(topic);
+        if (it == topicSubscribers_.end()) return;
+        auto& subs = it->second;
+        // Expired subscribers found on the way are unmatched too
+        int removed = 0;
+        subs.erase(std::remove_if(subs.begin(), subs.end(),
+            [&](std::weak_ptr<ISubscriber>& w_sub) {
+                auto locked = w_sub.lock();
+                if (locked && locked.get() != sub) return false;
+                removed++;
+                return true;
+            }),
+            subs.end());
+        unmatchSubscribersLocked(topic, removed, events);
+    }
+    events.fire();
+}
+
+MiniRosCore::TopicMemory& MiniRosCore::topicMemoryLocked(const std::string& topic) {
+    return topicMemory_[topic];
+}
+
+std::shared_ptr<TopicCharge> MiniRosCore::chargeTopicLocked(TopicMemory& memory, size_t bytes,
+                                                            const std::vector<std::weak_ptr<ISubscriber>>& subs) {
+    auto& counter = *memory.counter;
+    bool dropOldest = counter.policy() == OverflowPolicy::DropOldest;
+    while (counter.wouldExceed(bytes)) {
+        // Charges go away as the last queue holding a message pops it, on the
+        // subscriber's thread, so each entry is locked exactly once
+        std::shared_ptr<TopicCharge> oldest;
+        while (dropOldest && !oldest && !memory.charges.empty()) {
+            oldest = memory.charges.front().lock();
+            memory.charges.pop_front();
+        }
+        if (!oldest) {
+            counter.recordDrop(); // DropNewest, or nothing left to evict
+            return nullptr;
+        }
+        // Topic-wide DropOldest: the oldest message leaves every queue at once.
+        // A message being handled right now stays charged until its callback
+        // returns; it is skipped, and with nothing else to evict the newest
+        // is dropped
+        uint64_t sequence = oldest->sequence();
+        oldest.reset(); // Only the queues hold it while evicting
+        bool evicted = false;
+        for (auto& w_sub : subs) {
+            if (auto sub = w_sub.lock()) evicted |= sub->evictTopicMessage(sequence);
+        }
+        if (evicted) counter.recordDrop();
+    }
+    auto charge = std::make_shared<TopicCharge>(memory.counter, bytes, memory.nextSequence++);
+    if (dropOldest && counter.snapshot().byteBudget > 0) {
+        memory.charges.push_back(charge);
+    }
+    return charge;
+}
+
+MemoryStats MiniRosCore::getTopicMemoryStats(const std::string& topic) {
     std::lock_guard<std::mutex> lock(topicMutex_);
-    topicSubscribers_[sub->getTopicName()].push_back(sub);
+    auto it = topicMemory_.find(topic);
+    return it != topicMemory_.end() ? it->second.counter->snapshot() : MemoryStats();
+}
+
+void MiniRosCore::setTopicByteBudget(const std::string& topic, size_t maxBytes, OverflowPolicy policy) {
+    std::lock_guard<std::mutex> lock(topicMutex_);
+    auto& memory = topicMemoryLocked(topic);
+    memory.counter->setBudget(maxBytes, policy);
+    if (maxBytes == 0 || policy != OverflowPolicy::DropOldest) {
+        memory.charges.clear(); // Only DropOldest evicts
+    }
 }
 
 void MiniRosCore::registerServiceServer(std::shared_ptr<IServiceServer> server) {
@@ -46,21 +248,90 @@ std::shared_ptr<IServiceServer> MiniRosCore::findService(const std::string& serv
 void MiniRosCore::publish(const std::string& topic, std::shared_ptr<IMessage> msg) {
     if (!ok()) return;
     
-    std::lock_guard<std::mutex> lock(topicMutex_);
-    auto it = topicSubscribers_.find(topic);
-    if (it != topicSubscribers_.end()) {
+    PendingMatchEvents events;
+    {
+        std::lock_guard<std::mutex> lock(topicMutex_);
+        auto it = topicSubscribers_.find(topic);
+        if (it == topicSubscribers_.end()) return;
         auto& subs = it->second;
+        auto charge = chargeTopicLocked(topicMemoryLocked(topic), msg->byteSize(), subs);
+        if (!charge) return; // Over the topic budget
         // Clean up expired subscribers while iterating
+        int removed = 0;
         subs.erase(std::remove_if(subs.begin(), subs.end(),
             [&](std::weak_ptr<ISubscriber>& w_sub) {
                 if (auto sub = w_sub.lock()) {
-                    sub->enqueueRaw(msg); // This is the "transport"
+                    sub->enqueueCharged(msg, charge); // This is the "transport"
                     return false; // Keep
                 }
+                removed++;
                 return true; // Remove
             }),
             subs.end());
+        unmatchSubscribersLocked(topic, removed, events);
+    }
+    events.fire();
+}
+
+void MiniRosCore::publishBatch(const std::string& topic, const std::vector<std::shared_ptr<IMessage>>& msgs) {
+    if (!ok() || msgs.empty()) return;
+
+    PendingMatchEvents events;
+    {
+        std::lock_guard<std::mutex> lock(topicMutex_);
+        auto it = topicSubscribers_.find(topic);
+        if (it == topicSubscribers_.end()) return;
+        auto& subs = it->second;
+        auto& memory = topicMemoryLocked(topic);
+        std::vector<std::shared_ptr<IMessage>> admitted;
+        std::vector<std::shared_ptr<TopicCharge>> charges;
+        admitted.reserve(msgs.size());
+        charges.reserve(msgs.size());
+        int removed = 0; // Expired subscribers cleaned up
+        // One bulk push (and one wake-up) per subscriber
+        auto flush = [&]() {
+            if (admitted.empty()) return;
+            subs.erase(std::remove_if(subs.begin(), subs.end(),
+                [&](std::weak_ptr<ISubscriber>& w_sub) {
+                    if (auto sub = w_sub.lock()) {
+                        sub->enqueueChargedBatch(admitted, charges);
+                        return false; // Keep
+                    }
+                    removed++;
+                    return true; // Remove
+                }),
+                subs.end());
+            admitted.clear();
+            charges.clear();
+        };
+        for (auto& msg : msgs) {
+            size_t bytes = msg->byteSize();
+            // Queue what is admitted so far before evicting, so the batch
+            // behaves like the same messages published one by one
+            if (memory.counter->wouldExceed(bytes)) flush();
+            if (auto charge = chargeTopicLocked(memory, bytes, subs)) {
+                admitted.push_back(msg);
+                charges.push_back(std::move(charge));
+            }
+        }
+        flush();
+        unmatchSubscribersLocked(topic, removed, events);
+    }
+    events.fire();
+}
+
+void MiniRosCore::setClock(std::shared_ptr<Clock> clock) {
+    timeSource_.set(clock);
+}
+
+void MiniRosCore::useSimulatedTime(const std::string& topic) {
+    if (clockSubscriber_) {
+        unregisterSubscriber(clockSubscriber_.get()); // Switching topics or clocks
     }
+    auto clock = std::make_shared<SteppedClock>();
+    clockSubscriber_ = std::make_shared<ClockSubscriber>(topic, clock);
+    registerSubscriber(clockSubscriber_);
+    setClock(clock);
 }
 
 void MiniRosCore::shutdown() {
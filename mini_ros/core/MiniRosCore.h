@@ -2,9 +2,11 @@
 
 #include "Subscriber.h"
 #include "ServiceServer.h"
+#include "Clock.h"
 #include <string>
 #include <vector>
 #include <map>
+#include <deque>
 #include <mutex>
 #include <memory>
 #include <atomic>
@@ -15,9 +17,18 @@ namespace mini_ros {
 class Node;
 class Publisher;
 
-// MiniRosCore is a singleton that manages discovery
+// MiniRosCore manages discovery for one graph of nodes. Each instance is an
+// isolated context with its own registries, clock and lifecycle, so several
+// graphs (e.g. parallel test shards) can live in one process. getInstance()
+// returns the process-wide default context used by Node(name).
 class MiniRosCore {
 public:
+    MiniRosCore();
+    // Shuts the context down; it must outlive its nodes
+    ~MiniRosCore();
+    MiniRosCore(const MiniRosCore&) = delete;
+    MiniRosCore& operator=(const MiniRosCore&) = delete;
+
     static MiniRosCore& getInstance() {
         static MiniRosCore instance;
         return instance;
@@ -27,37 +38,85 @@ public:
     void registerNode(Node* node);
     void unregisterNode(Node* node);
 
-    void registerPublisher(Publisher* pub, const std::string& topic);
+    // Publishers and subscribers are matched by topic; both sides get their
+    // peer counts updated and matched/unmatched events fired
+    void registerPublisher(std::shared_ptr<Publisher> pub);
+    void unregisterPublisher(Publisher* pub);
     void registerSubscriber(std::shared_ptr<ISubscriber> sub);
+    void unregisterSubscriber(ISubscriber* sub);
     
     void registerServiceServer(std::shared_ptr<IServiceServer> server);
     std::shared_ptr<IServiceServer> findService(const std::string& serviceName);
     
+    // Memory held by messages queued on `topic`; a message queued on several
+    // subscribers counts once, until the last of them has handled it
+    MemoryStats getTopicMemoryStats(const std::string& topic);
+    // Caps the bytes queued on `topic` (0 = unlimited). Exceeding it applies
+    // `policy` topic-wide: DropNewest drops the message for every subscriber,
+    // DropOldest evicts the oldest message from every queue holding it.
+    void setTopicByteBudget(const std::string& topic, size_t maxBytes,
+                            OverflowPolicy policy = OverflowPolicy::DropOldest);
+
     // Called by Publishers
     void publish(const std::string& topic, std::shared_ptr<IMessage> msg);
+    void publishBatch(const std::string& topic, const std::vector<std::shared_ptr<IMessage>>& msgs);
+
+    // Time. All timestamps, latency stats, timers and timeouts use this clock.
+    const TimeSource& timeSource() const { return timeSource_; }
+    Clock::TimePoint now() const { return timeSource_.now(); }
+    // Switch clocks, e.g. to a SteppedClock for deterministic tests
+    void setClock(std::shared_ptr<Clock> clock);
+    // Follow ClockMessages published on `topic` (simulation or log replay)
+    void useSimulatedTime(const std::string& topic = "/clock");
 
     // Global shutdown
     void shutdown();
     bool ok() const;
 
 private:
-    MiniRosCore() = default;
-    ~MiniRosCore() = default;
-    MiniRosCore(const MiniRosCore&) = delete;
-    MiniRosCore& operator=(const MiniRosCore&) = delete;
-
     std::atomic<bool> running_{true};
 
+    TimeSource timeSource_;
+    std::shared_ptr<ISubscriber> clockSubscriber_; // Set by useSimulatedTime()
+
     // Registries
     std::mutex nodeMutex_;
     std::vector<Node*> nodes_;
 
     std::mutex topicMutex_;
-    // We don't need to store publishers, just subscribers
     std::map<std::string, std::vector<std::weak_ptr<ISubscriber>>> topicSubscribers_;
+    // Publishers are only tracked for subscription counts and match events.
+    // The raw pointer identifies the entry once the weak_ptr has expired.
+    struct PublisherEntry {
+        Publisher* raw;
+        std::weak_ptr<Publisher> pub;
+    };
+    std::map<std::string, std::vector<PublisherEntry>> topicPublishers_;
+
+    // Match events collected under topicMutex_ and fired after it is released
+    struct PendingMatchEvents;
+    // Lowers the subscription count of `topic`'s publishers after `removed`
+    // subscribers left it. Needs topicMutex_.
+    void unmatchSubscribersLocked(const std::string& topic, int removed, PendingMatchEvents& events);
+    // Topic-wide memory: each published message is charged once, however many
+    // subscribers queue it
+    struct TopicMemory {
+        std::shared_ptr<MemoryCounter> counter = std::make_shared<MemoryCounter>();
+        std::deque<std::weak_ptr<TopicCharge>> charges; // Publish order, for DropOldest
+        uint64_t nextSequence = 0;
+    };
+    std::map<std::string, TopicMemory> topicMemory_;
+
+    TopicMemory& topicMemoryLocked(const std::string& topic); // Needs topicMutex_
+    // Applies the topic budget to a message of `bytes` about to fan out to
+    // `subs`; returns its charge, or nullptr if the message is dropped
+    std::shared_ptr<TopicCharge> chargeTopicLocked(TopicMemory& memory, size_t bytes,
+                                                   const std::vector<std::weak_ptr<ISubscriber>>& subs);
 
     std::mutex serviceMutex_;
     std::map<std::string, std::weak_ptr<IServiceServer>> serviceServers_;
 };
 
+using Context = MiniRosCore;
+
 } // namespace mini_ros
\ No newline at end of file
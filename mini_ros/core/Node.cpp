@@ -1,18 +1,34 @@
 #include "Node.h"
 #include "MiniRosCore.h"
+#include "StdServices.h" // For SetParameter
 
 namespace mini_ros {
 
-Node::Node(const std::string& name) : name_(name) {
-    core_ = &MiniRosCore::getInstance();
+Node::Node(const std::string& name) : Node(name, MiniRosCore::getInstance()) {
+}
+
+Node::Node(const std::string& name, Context& context) : name_(name) {
+    core_ = &context;
+    time_ = &core_->timeSource();
+    deferredGeneration_ = time_->generation();
     core_->registerNode(this);
 }
 
 Node::~Node() {
     shutdown();
+    // Subscribers stop being matched once their node is gone, even if the
+    // caller still holds them
+    for (auto& sub : subscribers_) {
+        core_->unregisterSubscriber(sub.get());
+    }
     core_->unregisterNode(this);
 }
 
+void Node::addPublisher(std::shared_ptr<Publisher> pub) {
+    publishers_.push_back(pub);
+    core_->registerPublisher(pub);
+}
+
 void Node::addSubscriber(std::shared_ptr<ISubscriber> sub) {
     subscribers_.push_back(sub);
     core_->registerSubscriber(sub);
@@ -23,14 +39,103 @@ void Node::addServiceServer(std::shared_ptr<IServiceServer> server) {
     core_->registerServiceServer(server);
 }
 
+void Node::ensureParameterService() {
+    std::call_once(parameterServiceOnce_, [this]() {
+        createServiceServer<SetParameter>(name_ + "/set_parameter",
+            [this](SetParameter::RequestPtr req, SetParameter::ResponsePtr res) {
+                res->successful = parameters_.set(req->name, req->value);
+                if (!res->successful) {
+                    res->reason = parameters_.has(req->name)
+                        ? "type mismatch for parameter '" + req->name + "'"
+                        : "parameter '" + req->name + "' is not declared";
+                }
+                return true;
+            });
+    });
+}
+
+void Node::post(std::function<void()> fn) {
+    std::lock_guard<std::mutex> lock(postMutex_);
+    posted_.push_back(std::move(fn));
+}
+
+void Node::postAfter(std::chrono::duration<double> delay, std::function<void()> fn) {
+    auto clockDelay = std::chrono::duration_cast<Clock::Duration>(delay);
+    std::lock_guard<std::mutex> lock(postMutex_);
+    rebaseDeferredWork();
+    deferred_.push(DeferredWork{time_->now() + clockDelay, clockDelay, std::move(fn)});
+}
+
+// Called with postMutex_ held. Deadlines taken before a clock switch restart
+// their full delay on the new clock.
+void Node::rebaseDeferredWork() {
+    uint64_t generation = time_->generation();
+    if (generation == deferredGeneration_) return;
+    deferredGeneration_ = generation;
+    auto now = time_->now();
+    std::vector<DeferredWork> pending;
+    while (!deferred_.empty()) {
+        pending.push_back(deferred_.top());
+        deferred_.pop();
+    }
+    for (auto& work : pending) {
+        work.deadline = now + work.delay;
+        deferred_.push(std::move(work));
+    }
+}
+
+void Node::runPostedWork() {
+    std::vector<std::function<void()>> ready;
+    {
+        std::lock_guard<std::mutex> lock(postMutex_);
+        ready.swap(posted_);
+        rebaseDeferredWork();
+        auto now = time_->now();
+        while (!deferred_.empty() && deferred_.top().deadline <= now) {
+            ready.push_back(deferred_.top().fn);
+            deferred_.pop();
+        }
+    }
+    // Run outside the lock so work items can post again
+    for (auto& fn : ready) {
+        fn();
+    }
+}
+
 void Node::spin() {
     while (ok()) {
+        auto start = FastTimestamp::now();
         spinOnce();
+        auto busyEnd = FastTimestamp::now();
         // In a real-time system, you'd sleep for a precise duration here
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        auto idleEnd = FastTimestamp::now();
+
+        busyNanos_ += FastTimestamp::toNanos(busyEnd) - FastTimestamp::toNanos(start);
+        idleNanos_ += FastTimestamp::toNanos(idleEnd) - FastTimestamp::toNanos(busyEnd);
+    }
+}
+
+void Node::setProfilingEnabled(bool enabled) {
+    profiling_ = enabled;
+    for (auto& sub : subscribers_) {
+        sub->setProfilingEnabled(enabled);
+    }
+    for (auto& server : serviceServers_) {
+        server->setProfilingEnabled(enabled);
+    }
+    for (auto& timer : timers_) {
+        timer->setProfilingEnabled(enabled);
     }
 }
 
+ExecutorStats Node::getExecutorStats() const {
+    ExecutorStats stats;
+    stats.busySeconds = busyNanos_.load() * 1e-9;
+    stats.idleSeconds = idleNanos_.load() * 1e-9;
+    return stats;
+}
+
 void Node::spinOnce() {
     // Process all subscriber callbacks
     for (auto& sub : subscribers_) {
@@ -46,6 +151,9 @@ void Node::spinOnce() {
     for (auto& timer : timers_) {
         timer->spinOnce();
     }
+
+    // Process posted and deferred work
+    runPostedWork();
 }
 
 void Node::shutdown() {
@@ -5,27 +5,47 @@
 #include "ServiceClient.h"
 #include "ServiceServer.h"
 #include "Timer.h"
+#include "Parameters.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <queue>
+#include <functional>
 
 namespace mini_ros {
 
 // Forward declare
 class MiniRosCore;
+using Context = MiniRosCore;
+
+// How a node's spin() loop spent its time
+struct ExecutorStats {
+    double busySeconds = 0.0; // Inside spinOnce()
+    double idleSeconds = 0.0; // Sleeping between iterations
+
+    double busyRatio() const {
+        double total = busySeconds + idleSeconds;
+        return total > 0.0 ? busySeconds / total : 0.0;
+    }
+};
 
 class Node {
 public:
+    // Joins the default context (MiniRosCore::getInstance())
     Node(const std::string& name);
-    ~Node();
+    // Joins `context`, which must outlive the node
+    Node(const std::string& name, Context& context);
+    // Virtual so components (see Component.h) can be owned through Node*
+    virtual ~Node();
 
     // Factory methods for creating ROS primitives
     template<class MsgT>
     std::shared_ptr<Publisher> createPublisher(const std::string& topic) {
-        auto pub = std::make_shared<Publisher>(topic, core_);
-        publishers_.push_back(pub);
+        std::shared_ptr<Publisher> pub(new Publisher(topic, core_)); // Private constructor
+        addPublisher(pub);
         return pub;
     }
 
@@ -34,8 +54,9 @@ public:
         const std::string& topic, 
         std::function<void(std::shared_ptr<MsgT>)> callback
     ) {
-        auto sub = std::make_shared<Subscriber<MsgT>>(topic, callback);
+        auto sub = std::make_shared<Subscriber<MsgT>>(topic, callback, time_);
         addSubscriber(sub);
+        if (profiling_) sub->setProfilingEnabled(true);
         return sub;
     }
 
@@ -44,8 +65,9 @@ public:
         const std::string& service,
         typename ServiceServer<SrvT>::CallbackT callback
     ) {
-        auto server = std::make_shared<ServiceServer<SrvT>>(service, callback);
+        auto server = std::make_shared<ServiceServer<SrvT>>(service, callback, time_);
         addServiceServer(server);
+        if (profiling_) server->setProfilingEnabled(true);
         return server;
     }
 
@@ -57,29 +79,89 @@ public:
     }
 
     std::shared_ptr<Timer> createTimer(std::chrono::duration<double> period, Timer::CallbackT callback) {
-        auto timer = std::make_shared<Timer>(period, callback);
+        auto timer = std::make_shared<Timer>(period, callback, time_);
         timers_.push_back(timer);
+        if (profiling_) timer->setProfilingEnabled(true);
         return timer;
     }
 
+    // Parameters. Declaring the first one also starts the node's
+    // "<name>/set_parameter" service so other nodes can change them at runtime.
+    // Hot paths should keep the returned handle: handle.get() is a lock-free
+    // load for bool/int64_t/double; string and vector reads lock and copy.
+    template<class T>
+    ParameterHandle<T> declareParameter(const std::string& name, const T& defaultValue) {
+        ensureParameterService();
+        return parameters_.declare<T>(name, defaultValue);
+    }
+
+    // Returns false if `name` is undeclared or not of type T
+    template<class T>
+    bool getParameter(const std::string& name, T& value) const {
+        return parameters_.get<T>(name, value);
+    }
+
+    // Returns false if `name` is undeclared or `value` has the wrong type
+    template<class T>
+    bool setParameter(const std::string& name, const T& value) {
+        return parameters_.set(name, ParameterValue(value));
+    }
+
+    // Called after any parameter of this node changes (locally or remotely)
+    void onParameterChange(ParameterStore::CallbackT callback) {
+        parameters_.onChange(std::move(callback));
+    }
+
+    ParameterStore& parameters() { return parameters_; }
+
+    // Queue work to run on this node's spinning thread (thread-safe)
+    void post(std::function<void()> fn);
+
+    // Queue work to run on this node's spinning thread once `delay` has passed
+    void postAfter(std::chrono::duration<double> delay, std::function<void()> fn);
+
     // Main scheduler loop
     void spin();
     
     // Single spin iteration
     void spinOnce();
 
+    // Per-callback CPU-time and kernel-counter profiling for every subscriber,
+    // service server and timer of this node, including ones created later
+    void setProfilingEnabled(bool enabled);
+
+    // Busy/idle split of spin(), for spotting saturated nodes
+    ExecutorStats getExecutorStats() const;
+
     // Shutdown
     void shutdown();
     bool ok() const;
 
     std::string getName() const { return name_; }
+    Context& getContext() const { return *core_; }
+
+    // Current time on the core's clock (system, simulated or stepped)
+    Clock::TimePoint now() const { return time_->now(); }
 
 private:
+    // Work item scheduled with postAfter()
+    struct DeferredWork {
+        Clock::TimePoint deadline;
+        Clock::Duration delay; // To re-base the deadline after a clock switch
+        std::function<void()> fn;
+        bool operator>(const DeferredWork& other) const { return deadline > other.deadline; }
+    };
+
+    void addPublisher(std::shared_ptr<Publisher> pub);
     void addSubscriber(std::shared_ptr<ISubscriber> sub);
     void addServiceServer(std::shared_ptr<IServiceServer> server);
+    void runPostedWork();
+    void rebaseDeferredWork();
+    void ensureParameterService();
 
     std::string name_;
-    MiniRosCore* core_; // Raw pointer to singleton
+    MiniRosCore* core_; // Raw pointer to the node's context
+    const TimeSource* time_; // The core's clock
     
     // Lists of schedulable items
     std::vector<std::shared_ptr<Publisher>> publishers_;
@@ -87,8 +169,20 @@ private:
     std::vector<std::shared_ptr<ServiceClient>> serviceClients_;
     std::vector<std::shared_ptr<IServiceServer>> serviceServers_;
     std::vector<std::shared_ptr<Timer>> timers_;
+
+    ParameterStore parameters_;
+    std::once_flag parameterServiceOnce_;
+
+    // Work posted from other threads (e.g. coroutine resumptions)
+    std::mutex postMutex_;
+    std::vector<std::function<void()>> posted_;
+    std::priority_queue<DeferredWork, std::vector<DeferredWork>, std::greater<DeferredWork>> deferred_;
+    uint64_t deferredGeneration_; // Clock generation the deadlines were taken on
     
     std::atomic<bool> running_{true};
+    std::atomic<bool> profiling_{false};
+    std::atomic<int64_t> busyNanos_{0};
+    std::atomic<int64_t> idleNanos_{0};
 };
 
 } // namespace mini_ros
\ No newline at end of file
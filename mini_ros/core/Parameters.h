@@ -0,0 +1,183 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace mini_ros {
+
+// Value of a node parameter
+using ParameterValue = std::variant<bool, int64_t, double, std::string, std::vector<double>>;
+
+template<class T>
+struct IsParameterType
+    : std::integral_constant<bool,
+          std::is_same<T, bool>::value || std::is_same<T, int64_t>::value ||
+          std::is_same<T, double>::value || std::is_same<T, std::string>::value ||
+          std::is_same<T, std::vector<double>>::value> {};
+
+// Base class for type erasure
+class IParameterSlot {
+public:
+    virtual ~IParameterSlot() = default;
+    virtual ParameterValue value() const = 0;
+    // Returns false if `value` holds the wrong type
+    virtual bool set(const ParameterValue& value) = 0;
+};
+
+// Storage behind one parameter. Scalars (bool, int64_t, double) live in a
+// std::atomic: reads are a single lock-free load.
+template<class T, bool Scalar = std::is_arithmetic<T>::value>
+class ParameterCell {
+public:
+    explicit ParameterCell(const T& initial) : value_(initial) {}
+
+    T load() const { return value_.load(std::memory_order_acquire); }
+    void store(const T& value) { value_.store(value, std::memory_order_release); }
+
+private:
+    std::atomic<T> value_;
+};
+
+// Strings and vectors are published as immutable shared_ptr snapshots, and a
+// replaced version is freed as soon as the last reader holding it is done.
+// Reads are not lock-free: the shared_ptr atomics take a short lock (a global
+// mutex pool on libstdc++), and the value is copied out on every load.
+template<class T>
+class ParameterCell<T, false> {
+public:
+    explicit ParameterCell(const T& initial) : value_(std::make_shared<const T>(initial)) {}
+
+    T load() const { return *std::atomic_load_explicit(&value_, std::memory_order_acquire); }
+    void store(const T& value) {
+        std::atomic_store_explicit(&value_, std::make_shared<const T>(value), std::memory_order_release);
+    }
+
+private:
+    std::shared_ptr<const T> value_;
+};
+
+// One parameter. get() returns the value current at the time of the call;
+// see ParameterCell for what a read costs.
+template<class T>
+class ParameterSlot : public IParameterSlot {
+public:
+    explicit ParameterSlot(const T& initial) : cell_(initial) {}
+
+    T get() const { return cell_.load(); }
+
+    void store(const T& value) { cell_.store(value); }
+
+    ParameterValue value() const override { return ParameterValue(get()); }
+
+    bool set(const ParameterValue& value) override {
+        if (auto typed = std::get_if<T>(&value)) {
+            store(*typed);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    ParameterCell<T> cell_;
+};
+
+// Handle for hot paths. For scalars get() is a single lock-free atomic load;
+// for strings and vectors it briefly locks and copies the value, so read
+// those once per callback rather than per element.
+template<class T>
+class ParameterHandle {
+public:
+    ParameterHandle() = default;
+    explicit ParameterHandle(const ParameterSlot<T>* slot) : slot_(slot) {}
+
+    T get() const { return slot_->get(); }
+    // False if the parameter was already declared with another type
+    bool valid() const { return slot_ != nullptr; }
+
+private:
+    const ParameterSlot<T>* slot_ = nullptr;
+};
+
+// Per-node parameter registry. Name lookups lock; reads through a
+// ParameterHandle do not.
+class ParameterStore {
+public:
+    using CallbackT = std::function<void(const std::string& name, const ParameterValue& value)>;
+
+    // Declares `name` with a default, or returns the existing parameter if it
+    // already has type T. Returns an invalid handle on a type conflict.
+    template<class T>
+    ParameterHandle<T> declare(const std::string& name, const T& defaultValue) {
+        static_assert(IsParameterType<T>::value,
+                      "Parameters must be bool, int64_t, double, std::string or std::vector<double>");
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = slots_.find(name);
+        if (it != slots_.end()) {
+            return ParameterHandle<T>(dynamic_cast<const ParameterSlot<T>*>(it->second.get()));
+        }
+        auto slot = std::make_unique<ParameterSlot<T>>(defaultValue);
+        ParameterHandle<T> handle(slot.get());
+        slots_[name] = std::move(slot);
+        return handle;
+    }
+
+    bool has(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slots_.count(name) != 0;
+    }
+
+    // Returns false if `name` is undeclared or not of type T
+    template<class T>
+    bool get(const std::string& name, T& value) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = slots_.find(name);
+        if (it == slots_.end()) return false;
+        auto slot = dynamic_cast<const ParameterSlot<T>*>(it->second.get());
+        if (!slot) return false;
+        value = slot->get();
+        return true;
+    }
+
+    // Returns false if `name` is undeclared or `value` has the wrong type.
+    // Change callbacks run on the calling thread after the new value is visible.
+    bool set(const std::string& name, const ParameterValue& value) {
+        std::vector<CallbackT> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = slots_.find(name);
+            if (it == slots_.end() || !it->second->set(value)) return false;
+            callbacks = callbacks_;
+        }
+        for (auto& callback : callbacks) {
+            callback(name, value);
+        }
+        return true;
+    }
+
+    void onChange(CallbackT callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks_.push_back(std::move(callback));
+    }
+
+    std::vector<std::string> names() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> result;
+        for (const auto& entry : slots_) result.push_back(entry.first);
+        return result;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<IParameterSlot>> slots_;
+    std::vector<CallbackT> callbacks_;
+};
+
+} // namespace mini_ros
@@ -5,12 +5,26 @@ namespace mini_ros {
 
 Publisher::Publisher(const std::string& topic, MiniRosCore* core)
     : topicName_(topic), core_(core) {
-    // Register this publisher with the core
-    core_->registerPublisher(this, topicName_);
+    // Node::createPublisher() registers this publisher with the core once
+    // it is held by a shared_ptr
+}
+
+Publisher::~Publisher() {
+    core_->unregisterPublisher(this);
+}
+
+Clock::TimePoint Publisher::now() const {
+    return core_->now();
 }
 
 void Publisher::doPublish(std::shared_ptr<IMessage> msg) {
+    if (!hasSubscribers()) return; // Nobody listening: skip the topic lock
     core_->publish(topicName_, msg);
 }
 
+void Publisher::doPublishBatch(const std::vector<std::shared_ptr<IMessage>>& msgs) {
+    if (!hasSubscribers()) return;
+    core_->publishBatch(topicName_, msgs);
+}
+
 } // namespace mini_ros
\ No newline at end of file
@@ -1,30 +1,71 @@
 #pragma once
 
 #include "IMessage.h"
+#include "Clock.h"
+#include "MatchEvents.h"
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace mini_ros {
 
-// Forward declare
+// Forward declares
 class MiniRosCore;
+class Node;
 
+// Created through Node::createPublisher(), which registers it with the core
 class Publisher {
 public:
-    // Publisher is created by a Node, which passes a reference to the core
-    Publisher(const std::string& topic, MiniRosCore* core);
+    ~Publisher();
+
+    Publisher(const Publisher&) = delete;
+    Publisher& operator=(const Publisher&) = delete;
+
+    // Number of subscribers currently matched on this topic
+    size_t getSubscriptionCount() const { return matches_.count(); }
+
+    // Single atomic load: skip building messages nobody will receive
+    bool hasSubscribers() const { return matches_.count() != 0; }
+
+    // Fired (outside core locks) as subscribers appear on / leave the topic
+    void onMatched(MatchTracker::CallbackT callback) { matches_.onMatched(std::move(callback)); }
+    void onUnmatched(MatchTracker::CallbackT callback) { matches_.onUnmatched(std::move(callback)); }
+
+    MatchTracker& matchTracker() { return matches_; } // Used by the core
+    const std::string& getTopicName() const { return topicName_; }
 
     template<class MsgT>
     void publish(std::shared_ptr<MsgT> msg) {
         // Set timestamp right before publishing
-        msg->timestamp = std::chrono::high_resolution_clock::now();
+        msg->timestamp = now();
         doPublish(msg);
     }
 
+    // Publishes many messages at once: one timestamp, one subscriber lookup,
+    // and one queue push and wake-up per subscriber
+    template<class MsgT>
+    void publishBatch(const std::vector<std::shared_ptr<MsgT>>& msgs) {
+        if (msgs.empty()) return;
+        auto stamp = now();
+        std::vector<std::shared_ptr<IMessage>> batch;
+        batch.reserve(msgs.size());
+        for (const auto& msg : msgs) {
+            msg->timestamp = stamp;
+            batch.push_back(msg);
+        }
+        doPublishBatch(batch);
+    }
+
 private:
+    friend class Node;
+    Publisher(const std::string& topic, MiniRosCore* core);
+
+    Clock::TimePoint now() const; // Core clock
     void doPublish(std::shared_ptr<IMessage> msg);
+    void doPublishBatch(const std::vector<std::shared_ptr<IMessage>>& msgs);
     std::string topicName_;
-    MiniRosCore* core_; // Raw pointer to the singleton core
+    MiniRosCore* core_; // Raw pointer to the owning context
+    MatchTracker matches_;
 };
 
 } // namespace mini_ros
\ No newline at end of file
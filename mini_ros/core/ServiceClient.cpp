@@ -4,7 +4,24 @@
 namespace mini_ros {
 
 ServiceClient::ServiceClient(const std::string& serviceName, MiniRosCore* core)
-    : serviceName_(serviceName), core_(core) {
+    : serviceName_(serviceName), core_(core), time_(&core->timeSource()) {
+}
+
+bool ServiceClient::callAsync(IService::RequestPtr req, std::function<void(IService::ResponsePtr)> done) {
+    auto server = findServer();
+    if (!server) {
+        return false; // Service not found
+    }
+    server->enqueueCall(req, std::move(done));
+    return true;
+}
+
+std::shared_ptr<PendingResponse> ServiceClient::send(IService::RequestPtr req) {
+    auto pending = std::make_shared<PendingResponse>();
+    if (!callAsync(req, [pending](IService::ResponsePtr res) { pending->complete(res); })) {
+        return nullptr;
+    }
+    return pending;
 }
 
 std::shared_ptr<IServiceServer> ServiceClient::findServer() {
@@ -1,15 +1,66 @@
 #pragma once
 
 #include "IService.h"
+#include "ServiceServer.h" // enqueueCall() is used by the call templates
+#include "Clock.h"
+#include "WaitSignal.h"
 #include <string>
 #include <memory>
 #include <future>
+#include <functional>
+#include <chrono>
+#include <atomic>
+#include <mutex>
 
 namespace mini_ros {
 
 // Forward declare
 class MiniRosCore;
-class IServiceServer;
+class ServiceClient;
+
+// Handle for a non-blocking call, returned by ServiceClient::call(req).
+// Either attach a continuation with then(), or co_await it (see Coroutine.h).
+template<class SrvT>
+struct AsyncCall {
+    ServiceClient* client;
+    typename SrvT::RequestPtr request;
+
+    // Returns false if the service was not found; `done` is then never invoked.
+    // Otherwise `done` runs on the server's spinning thread with the response
+    // (nullptr if the server callback reported failure).
+    bool then(std::function<void(typename SrvT::ResponsePtr)> done);
+};
+
+// Response of a call started with ServiceClient::send(). Poll it, or attach
+// it to a WaitSet to block until it completes.
+class PendingResponse {
+public:
+    bool isReady() const { return ready_.load(std::memory_order_acquire); }
+
+    // The response once ready; nullptr before that or if the server callback failed
+    template<class SrvT>
+    typename SrvT::ResponsePtr get() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::static_pointer_cast<typename SrvT::Response>(response_);
+    }
+
+    void complete(IService::ResponsePtr res) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            response_ = std::move(res);
+        }
+        ready_.store(true, std::memory_order_release);
+        notifier_.notify();
+    }
+
+    ReadyNotifier& readyNotifier() { return notifier_; } // Used by WaitSet
+
+private:
+    mutable std::mutex mutex_;
+    IService::ResponsePtr response_;
+    std::atomic<bool> ready_{false};
+    ReadyNotifier notifier_;
+};
 
 class ServiceClient {
 public:
@@ -38,10 +89,66 @@ public:
         return false;
     }
 
+    // Synchronous call that gives up after `timeout` on the core's clock, so
+    // timeouts follow simulated and stepped time. The request stays queued on
+    // the server; its late response is discarded.
+    template<class SrvT>
+    bool call(typename SrvT::RequestPtr req, typename SrvT::ResponsePtr& res,
+              std::chrono::duration<double> timeout) {
+        auto server = findServer();
+        if (!server) {
+            return false; // Service not found
+        }
+
+        auto future = server->enqueueCall(req);
+        auto clockTimeout = std::chrono::duration_cast<Clock::Duration>(timeout);
+        auto deadline = time_->now() + clockTimeout;
+        uint64_t generation = time_->generation();
+        // Poll in short real-time slices so a simulated clock can move the deadline
+        while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+            if (time_->generation() != generation) {
+                // The core switched clocks: restart the timeout on the new one
+                generation = time_->generation();
+                deadline = time_->now() + clockTimeout;
+            }
+            if (time_->now() >= deadline) {
+                return false; // Timed out
+            }
+        }
+
+        auto baseRes = future.get();
+        if (baseRes) {
+            res = std::static_pointer_cast<typename SrvT::Response>(baseRes);
+            return true;
+        }
+        return false;
+    }
+
+    // Non-blocking call; see AsyncCall
+    template<class SrvT>
+    AsyncCall<SrvT> call(typename SrvT::RequestPtr req) {
+        return AsyncCall<SrvT>{this, req};
+    }
+
+    // Type-erased non-blocking call. Returns false if the service was not found.
+    bool callAsync(IService::RequestPtr req, std::function<void(IService::ResponsePtr)> done);
+
+    // Non-blocking call completed into a PendingResponse (e.g. for a WaitSet).
+    // Returns nullptr if the service was not found.
+    std::shared_ptr<PendingResponse> send(IService::RequestPtr req);
+
 private:
     std::shared_ptr<IServiceServer> findServer();
     std::string serviceName_;
     MiniRosCore* core_;
+    const TimeSource* time_; // The core's clock
 };
 
+template<class SrvT>
+bool AsyncCall<SrvT>::then(std::function<void(typename SrvT::ResponsePtr)> done) {
+    return client->callAsync(request, [done](IService::ResponsePtr res) {
+        done(std::static_pointer_cast<typename SrvT::Response>(res));
+    });
+}
+
 } // namespace mini_ros
\ No newline at end of file
@@ -3,9 +3,19 @@
 #include "IService.h"
 #include "../common/ThreadSafeQueue.h"
 #include "Statistics.h" // For performance analysis
+#include "CallbackProfiler.h"
+#include "WaitSignal.h"
+#include "Clock.h"
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 #include <future> // For pending calls
 
 namespace mini_ros {
@@ -14,6 +24,44 @@ namespace mini_ros {
 struct PendingCall {
     IService::RequestPtr request;
     std::promise<IService::ResponsePtr> promise;
+    // If set, invoked with the response instead of fulfilling the promise
+    std::function<void(IService::ResponsePtr)> onComplete;
+
+    // Memoization (see ServiceServer::enableMemoization)
+    bool memoized = false;  // Registered as the in-flight call for `key`
+    std::string key;
+    std::vector<std::shared_ptr<PendingCall>> followers; // Identical calls sharing this execution
+    bool fromCache = false; // Answer with `cachedResponse` without running the callback
+    IService::ResponsePtr cachedResponse;
+
+    // Followers are only appended while the call is in flight, so by the time
+    // the server completes it the list is final
+    void complete(IService::ResponsePtr res) {
+        if (onComplete) {
+            onComplete(res);
+        } else {
+            promise.set_value(res);
+        }
+        for (auto& follower : followers) {
+            follower->complete(res);
+        }
+    }
+};
+
+// Response cache of a memoizing ServiceServer
+struct MemoizeOptions {
+    size_t cacheCapacity = 0;               // Responses kept, least recently used evicted (0 = coalesce only)
+    // Lifetime of a cached response on the core clock (0 = until evicted).
+    // Entries cached before a clock switch count as expired.
+    std::chrono::duration<double> ttl{0.0};
+};
+
+struct MemoStats {
+    uint64_t executions = 0;  // Callback runs for memoized calls
+    uint64_t coalesced = 0;   // Calls that joined an identical in-flight call
+    uint64_t cacheHits = 0;   // Calls answered from the cache
+    uint64_t evictions = 0;   // Cached responses dropped for capacity
+    uint64_t expirations = 0; // Cached responses dropped for age
 };
 
 // Base class for type erasure
@@ -24,7 +72,20 @@ public:
     virtual std::string getServiceName() const = 0;
     // Called by a ServiceClient
     virtual std::future<IService::ResponsePtr> enqueueCall(IService::RequestPtr req) = 0;
+    // Asynchronous variant: onComplete runs on the server's spinning thread
+    virtual void enqueueCall(IService::RequestPtr req,
+                             std::function<void(IService::ResponsePtr)> onComplete) = 0;
     virtual Statistics getStats() const = 0;
+    // Optional CPU-time / kernel-counter profiling of the callback
+    virtual void setProfilingEnabled(bool enabled) = 0;
+    virtual CallbackProfile getProfile() const = 0;
+
+    // True if calls are queued (see WaitSet)
+    virtual bool hasPending() const { return false; }
+    ReadyNotifier& readyNotifier() { return ready_; } // Used by WaitSet
+
+private:
+    ReadyNotifier ready_;
 };
 
 template<class SrvT>
@@ -33,44 +94,197 @@ public:
     using RequestPtr = typename SrvT::RequestPtr;
     using ResponsePtr = typename SrvT::ResponsePtr;
     using CallbackT = std::function<bool(RequestPtr, ResponsePtr)>;
+    using KeyT = std::function<std::string(const typename SrvT::Request&)>;
+
+    // Cache TTLs are measured on `time` (the core's clock) when given
+    ServiceServer(const std::string& serviceName, CallbackT callback, const TimeSource* time = nullptr)
+        : serviceName_(serviceName), callback_(callback), time_(time) {}
+
+    // Opt-in for idempotent services: calls with the same key share one
+    // callback execution and one response object (treat it as read-only), and
+    // with a cache capacity, later calls are answered without running the
+    // callback at all. Only successful responses are cached. Call before
+    // clients start calling.
+    void enableMemoization(KeyT key, MemoizeOptions options = MemoizeOptions()) {
+        std::lock_guard<std::mutex> lock(memoMutex_);
+        keyFn_ = std::move(key);
+        memoOptions_ = options;
+        memoizing_.store(true, std::memory_order_release);
+    }
 
-    ServiceServer(const std::string& serviceName, CallbackT callback)
-        : serviceName_(serviceName), callback_(callback) {}
+    // Keys requests by their bytes; needs a trivially copyable Request.
+    // Equal requests with different padding bytes are simply not coalesced.
+    void enableMemoization(MemoizeOptions options = MemoizeOptions()) {
+        using Request = typename SrvT::Request;
+        static_assert(std::is_trivially_copyable<Request>::value,
+                      "Pass a key function for requests that are not trivially copyable");
+        enableMemoization([](const Request& req) {
+            return std::string(reinterpret_cast<const char*>(&req), sizeof(Request));
+        }, options);
+    }
+
+    MemoStats getMemoStats() const {
+        std::lock_guard<std::mutex> lock(memoMutex_);
+        return memoStats_;
+    }
 
     void spinOnce() override {
         std::shared_ptr<PendingCall> call;
         if (queue_.try_pop(call)) {
+            if (call->fromCache) {
+                call->complete(call->cachedResponse);
+                return;
+            }
             Stopwatch sw;
             auto req = std::static_pointer_cast<typename SrvT::Request>(call->request);
             auto res = std::make_shared<typename SrvT::Response>();
             
-            bool success = callback_(req, res);
+            bool success;
+            {
+                ProfileScope profile(profiling_ ? &profile_ : nullptr);
+                success = callback_(req, res);
+            }
             stats_.add(sw.elapsed());
 
-            if (success) {
-                call->promise.set_value(res);
-            } else {
-                // Set an exception or a null response to indicate failure
-                call->promise.set_value(nullptr); 
+            // A null response indicates failure
+            IService::ResponsePtr result = success ? IService::ResponsePtr(res) : nullptr;
+            if (call->memoized) {
+                finishMemoized(*call, result);
             }
+            call->complete(result);
         }
     }
 
     std::future<IService::ResponsePtr> enqueueCall(IService::RequestPtr req) override {
         auto call = std::make_shared<PendingCall>();
         call->request = req;
+        auto future = call->promise.get_future();
+        if (memoizing_.load(std::memory_order_acquire) && admitMemoized(call)) {
+            return future;
+        }
         queue_.push(call);
-        return call->promise.get_future();
+        readyNotifier().notify();
+        return future;
+    }
+
+    void enqueueCall(IService::RequestPtr req,
+                     std::function<void(IService::ResponsePtr)> onComplete) override {
+        auto call = std::make_shared<PendingCall>();
+        call->request = req;
+        call->onComplete = std::move(onComplete);
+        if (memoizing_.load(std::memory_order_acquire) && admitMemoized(call)) {
+            return;
+        }
+        queue_.push(call);
+        readyNotifier().notify();
     }
 
     std::string getServiceName() const override { return serviceName_; }
+    bool hasPending() const override { return !queue_.empty(); }
     Statistics getStats() const override { return stats_; }
+    void setProfilingEnabled(bool enabled) override { profiling_ = enabled; }
+    CallbackProfile getProfile() const override { return profile_; }
 
 private:
+    struct CacheEntry {
+        std::string key;
+        IService::ResponsePtr response;
+        Clock::TimePoint expires; // Ignored when ttl is 0
+        uint64_t generation;      // Clock generation expires was taken on
+    };
+    using CacheList = std::list<CacheEntry>;
+
+    Clock::TimePoint now() const { return time_ ? time_->now() : std::chrono::high_resolution_clock::now(); }
+    uint64_t clockGeneration() const { return time_ ? time_->generation() : 0; }
+
+    // Called with memoMutex_ held
+    bool expired(const CacheEntry& entry) const {
+        if (memoOptions_.ttl.count() <= 0.0) return false;
+        return entry.generation != clockGeneration() || now() >= entry.expires;
+    }
+
+    // Returns true if `call` was answered or attached to an in-flight call
+    // and must not be queued. Async cache hits are still queued, flagged
+    // fromCache, so onComplete runs on the server's spinning thread as usual.
+    bool admitMemoized(const std::shared_ptr<PendingCall>& call) {
+        std::string key = keyFn_(*std::static_pointer_cast<typename SrvT::Request>(call->request));
+        IService::ResponsePtr hit;
+        {
+            std::lock_guard<std::mutex> lock(memoMutex_);
+            auto cached = cacheIndex_.find(key);
+            if (cached != cacheIndex_.end()) {
+                auto entry = cached->second;
+                if (expired(*entry)) {
+                    cacheIndex_.erase(cached);
+                    cache_.erase(entry);
+                    memoStats_.expirations++;
+                } else {
+                    cache_.splice(cache_.begin(), cache_, entry); // Most recently used
+                    memoStats_.cacheHits++;
+                    hit = entry->response;
+                }
+            }
+            if (!hit) {
+                auto inFlight = inFlight_.find(key);
+                if (inFlight != inFlight_.end()) {
+                    inFlight->second->followers.push_back(call);
+                    memoStats_.coalesced++;
+                    return true;
+                }
+                call->memoized = true;
+                call->key = std::move(key);
+                inFlight_[call->key] = call.get();
+                return false;
+            }
+        }
+        if (call->onComplete) {
+            call->fromCache = true;
+            call->cachedResponse = hit;
+            return false;
+        }
+        call->promise.set_value(hit);
+        return true;
+    }
+
+    // Retires the in-flight entry and caches a successful response
+    void finishMemoized(const PendingCall& call, const IService::ResponsePtr& result) {
+        std::lock_guard<std::mutex> lock(memoMutex_);
+        inFlight_.erase(call.key);
+        memoStats_.executions++;
+        if (!result || memoOptions_.cacheCapacity == 0) return;
+
+        Clock::TimePoint expires = now() + std::chrono::duration_cast<Clock::Duration>(memoOptions_.ttl);
+        auto existing = cacheIndex_.find(call.key);
+        if (existing != cacheIndex_.end()) {
+            cache_.erase(existing->second);
+            cacheIndex_.erase(existing);
+        }
+        cache_.push_front(CacheEntry{call.key, result, expires, clockGeneration()});
+        cacheIndex_[call.key] = cache_.begin();
+        while (cache_.size() > memoOptions_.cacheCapacity) {
+            cacheIndex_.erase(cache_.back().key);
+            cache_.pop_back();
+            memoStats_.evictions++;
+        }
+    }
+
     std::string serviceName_;
     CallbackT callback_;
+    const TimeSource* time_;
     ThreadSafeQueue<std::shared_ptr<PendingCall>> queue_;
     Statistics stats_; // Callback duration stats
+    std::atomic<bool> profiling_{false};
+    CallbackProfile profile_; // CPU time / kernel counters, when profiling
+
+    // Memoization state, guarded by memoMutex_
+    std::atomic<bool> memoizing_{false};
+    mutable std::mutex memoMutex_;
+    KeyT keyFn_;
+    MemoizeOptions memoOptions_;
+    std::unordered_map<std::string, PendingCall*> inFlight_; // Owned by the queue / spinning thread
+    CacheList cache_; // Front = most recently used
+    std::unordered_map<std::string, typename CacheList::iterator> cacheIndex_;
+    MemoStats memoStats_;
 };
 
 } // namespace mini_ros
\ No newline at end of file
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "IMessage.h"
+#include "../common/AlignedBuffer.h"
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <cstring> // For memcpy
+
+namespace mini_ros {
+
+namespace detail {
+
+// Helpers for the flat little-endian layouts used by the messages below
+template<typename T>
+void appendPod(std::vector<uint8_t>& buffer, const T& value) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template<typename T>
+bool readPod(const std::vector<uint8_t>& buffer, size_t& offset, T& value) {
+    if (offset + sizeof(T) > buffer.size()) return false;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+template<typename T>
+void appendArray(std::vector<uint8_t>& buffer, const AlignedBuffer<T>& array) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + array.bytes());
+    if (!array.empty()) std::memcpy(buffer.data() + offset, array.data(), array.bytes());
+}
+
+template<typename T>
+bool readArray(const std::vector<uint8_t>& buffer, size_t& offset, size_t count, AlignedBuffer<T>& array) {
+    if (offset + count * sizeof(T) > buffer.size()) return false;
+    array.resize(count);
+    if (count) std::memcpy(array.data(), buffer.data() + offset, count * sizeof(T));
+    offset += count * sizeof(T);
+    return true;
+}
+
+} // namespace detail
+
+// 3D point cloud stored as structure-of-arrays: one 64-byte-aligned buffer per
+// field, so kernels can stream each coordinate with full-width vector loads.
+struct PointCloudMessage : public IMessage {
+    std::string frameId;
+    AlignedBuffer<float> x;
+    AlignedBuffer<float> y;
+    AlignedBuffer<float> z;
+    AlignedBuffer<float> intensity;
+
+    PointCloudMessage() = default;
+
+    // All field buffers draw from `allocator` (e.g. a pool or shared-memory segment)
+    explicit PointCloudMessage(BufferAllocator* allocator)
+        : x(allocator), y(allocator), z(allocator), intensity(allocator) {}
+
+    size_t size() const { return x.size(); }
+
+    // True if every field buffer holds size() values
+    bool consistent() const {
+        return y.size() == x.size() && z.size() == x.size() && intensity.size() == x.size();
+    }
+
+    size_t byteSize() const override {
+        return sizeof(*this) + frameId.capacity() +
+               (x.capacity() + y.capacity() + z.capacity() + intensity.capacity()) * sizeof(float);
+    }
+
+    void resize(size_t count) {
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+        intensity.resize(count);
+    }
+
+    void reserve(size_t count) {
+        x.reserve(count);
+        y.reserve(count);
+        z.reserve(count);
+        intensity.reserve(count);
+    }
+
+    void addPoint(float px, float py, float pz, float pi = 0.0f) {
+        x.push_back(px);
+        y.push_back(py);
+        z.push_back(pz);
+        intensity.push_back(pi);
+    }
+
+    std::vector<uint8_t> serialize() const {
+        std::vector<uint8_t> buffer;
+        buffer.reserve(sizeof(uint32_t) * 2 + frameId.size() + 4 * x.bytes());
+        detail::appendPod(buffer, static_cast<uint32_t>(frameId.size()));
+        buffer.insert(buffer.end(), frameId.begin(), frameId.end());
+        detail::appendPod(buffer, static_cast<uint32_t>(size()));
+        detail::appendArray(buffer, x);
+        detail::appendArray(buffer, y);
+        detail::appendArray(buffer, z);
+        detail::appendArray(buffer, intensity);
+        return buffer;
+    }
+
+    // A truncated buffer leaves an empty cloud
+    void deserialize(const std::vector<uint8_t>& buffer) {
+        size_t offset = 0;
+        uint32_t idLength = 0;
+        if (!detail::readPod(buffer, offset, idLength) || offset + idLength > buffer.size()) return;
+        frameId.assign(buffer.begin() + offset, buffer.begin() + offset + idLength);
+        offset += idLength;
+        uint32_t count = 0;
+        if (!detail::readPod(buffer, offset, count)) return;
+        if (!detail::readArray(buffer, offset, count, x) ||
+            !detail::readArray(buffer, offset, count, y) ||
+            !detail::readArray(buffer, offset, count, z) ||
+            !detail::readArray(buffer, offset, count, intensity)) {
+            resize(0);
+        }
+    }
+};
+
+enum class PixelFormat : uint8_t {
+    MONO8,
+    RGB8,
+    BGR8,
+    RGBA8,
+    BGRA8,
+};
+
+inline uint32_t bytesPerPixel(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::MONO8: return 1;
+        case PixelFormat::RGB8:
+        case PixelFormat::BGR8: return 3;
+        case PixelFormat::RGBA8:
+        case PixelFormat::BGRA8: return 4;
+    }
+    return 0;
+}
+
+// Interleaved 8-bit image with a 64-byte-aligned pixel buffer
+struct ImageMessage : public IMessage {
+    std::string frameId;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    PixelFormat format = PixelFormat::MONO8;
+    uint32_t step = 0; // Bytes per row
+    AlignedBuffer<uint8_t> data;
+
+    ImageMessage() = default;
+
+    explicit ImageMessage(BufferAllocator* allocator) : data(allocator) {}
+
+    size_t byteSize() const override { return sizeof(*this) + frameId.capacity() + data.capacity(); }
+
+    // True if the format is known, rows fit in `step` and `data` holds every row
+    bool consistent() const {
+        uint32_t bpp = bytesPerPixel(format);
+        return bpp != 0 && step >= static_cast<uint64_t>(width) * bpp &&
+               data.size() >= static_cast<uint64_t>(step) * height;
+    }
+
+    // Allocates a tightly packed (step == width * bpp) image
+    void allocate(uint32_t w, uint32_t h, PixelFormat fmt) {
+        width = w;
+        height = h;
+        format = fmt;
+        step = w * bytesPerPixel(fmt);
+        data.resize(static_cast<size_t>(step) * h);
+    }
+
+    std::vector<uint8_t> serialize() const {
+        std::vector<uint8_t> buffer;
+        buffer.reserve(sizeof(uint32_t) * 4 + 1 + frameId.size() + data.bytes());
+        detail::appendPod(buffer, static_cast<uint32_t>(frameId.size()));
+        buffer.insert(buffer.end(), frameId.begin(), frameId.end());
+        detail::appendPod(buffer, width);
+        detail::appendPod(buffer, height);
+        detail::appendPod(buffer, static_cast<uint8_t>(format));
+        detail::appendPod(buffer, step);
+        detail::appendArray(buffer, data);
+        return buffer;
+    }
+
+    // A truncated buffer or inconsistent geometry leaves an empty image
+    void deserialize(const std::vector<uint8_t>& buffer) {
+        size_t offset = 0;
+        uint32_t idLength = 0;
+        if (!detail::readPod(buffer, offset, idLength) || offset + idLength > buffer.size()) return;
+        frameId.assign(buffer.begin() + offset, buffer.begin() + offset + idLength);
+        offset += idLength;
+        uint8_t fmt = 0;
+        bool ok = detail::readPod(buffer, offset, width) &&
+                  detail::readPod(buffer, offset, height) &&
+                  detail::readPod(buffer, offset, fmt) &&
+                  detail::readPod(buffer, offset, step);
+        format = static_cast<PixelFormat>(fmt);
+        uint32_t bpp = bytesPerPixel(format);
+        if (!ok || bpp == 0 || step < static_cast<uint64_t>(width) * bpp ||
+            !detail::readArray(buffer, offset, static_cast<size_t>(step) * height, data)) {
+            width = height = step = 0;
+            format = PixelFormat::MONO8;
+            data.clear();
+        }
+    }
+};
+
+// Simulation / replay time, consumed by MiniRosCore::useSimulatedTime()
+struct ClockMessage : public IMessage {
+    int64_t nanoseconds = 0; // Time since the clock's epoch
+
+    size_t byteSize() const override { return sizeof(*this); }
+
+    std::vector<uint8_t> serialize() const {
+        std::vector<uint8_t> buffer;
+        detail::appendPod(buffer, nanoseconds);
+        return buffer;
+    }
+
+    void deserialize(const std::vector<uint8_t>& buffer) {
+        size_t offset = 0;
+        detail::readPod(buffer, offset, nanoseconds);
+    }
+};
+
+// Inertial measurement sample
+struct ImuMessage : public IMessage {
+    std::string frameId;
+    double orientation[4] = {0.0, 0.0, 0.0, 1.0}; // Quaternion (x, y, z, w)
+    double angularVelocity[3] = {0.0, 0.0, 0.0}; // rad/s
+    double linearAcceleration[3] = {0.0, 0.0, 0.0}; // m/s^2
+
+    size_t byteSize() const override { return sizeof(*this) + frameId.capacity(); }
+
+    std::vector<uint8_t> serialize() const {
+        std::vector<uint8_t> buffer;
+        detail::appendPod(buffer, static_cast<uint32_t>(frameId.size()));
+        buffer.insert(buffer.end(), frameId.begin(), frameId.end());
+        detail::appendPod(buffer, orientation);
+        detail::appendPod(buffer, angularVelocity);
+        detail::appendPod(buffer, linearAcceleration);
+        return buffer;
+    }
+
+    void deserialize(const std::vector<uint8_t>& buffer) {
+        size_t offset = 0;
+        uint32_t idLength = 0;
+        if (!detail::readPod(buffer, offset, idLength) || offset + idLength > buffer.size()) return;
+        frameId.assign(buffer.begin() + offset, buffer.begin() + offset + idLength);
+        offset += idLength;
+        detail::readPod(buffer, offset, orientation) &&
+            detail::readPod(buffer, offset, angularVelocity) &&
+            detail::readPod(buffer, offset, linearAcceleration);
+    }
+};
+
+} // namespace mini_ros
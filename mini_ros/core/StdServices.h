@@ -1,6 +1,8 @@
 #pragma once
 
 #include "IService.h"
+#include "Parameters.h"
+#include <string>
 
 namespace mini_ros {
 
@@ -21,4 +23,22 @@ struct AddTwoInts : public IService {
     using ResponsePtr = std::shared_ptr<Response>;
 };
 
+// Sets a parameter on a remote node. Every node that declares parameters
+// serves this as "<node_name>/set_parameter".
+struct SetParameter : public IService {
+
+    struct Request {
+        std::string name;
+        ParameterValue value;
+    };
+
+    struct Response {
+        bool successful;
+        std::string reason; // Why the set was rejected
+    };
+
+    using RequestPtr = std::shared_ptr<Request>;
+    using ResponsePtr = std::shared_ptr<Response>;
+};
+
 } // namespace mini_ros
\ No newline at end of file
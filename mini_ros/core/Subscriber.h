@@ -1,12 +1,19 @@
 #pragma once
 
 #include "IMessage.h"
+#include "Clock.h"
+#include "MatchEvents.h"
+#include "MemoryAccounting.h"
+#include "WaitSignal.h"
 #include "../common/ThreadSafeQueue.h"
 #include "Statistics.h" // For performance analysis
+#include "CallbackProfiler.h"
+#include <atomic>
 #include <memory>
 #include <functional>
 #include <string>
 #include <vector>
+#include <mutex>
 
 namespace mini_ros {
 
@@ -20,48 +27,221 @@ public:
     virtual void spinOnce() = 0; // Polls the queue and fires callback
     virtual std::string getTopicName() const = 0;
     virtual void enqueueRaw(std::shared_ptr<IMessage> msg) = 0;
+    virtual void enqueueRawBatch(const std::vector<std::shared_ptr<IMessage>>& msgs) = 0;
     virtual Statistics getStats() const = 0;
+    // Optional CPU-time / kernel-counter profiling of the callback
+    virtual void setProfilingEnabled(bool enabled) = 0;
+    virtual CallbackProfile getProfile() const = 0;
+
+    // Number of publishers currently matched on this topic
+    size_t getPublisherCount() const { return matches_.count(); }
+
+    // Fired (outside core locks) as publishers appear on / leave the topic
+    void onMatched(MatchTracker::CallbackT callback) { matches_.onMatched(std::move(callback)); }
+    void onUnmatched(MatchTracker::CallbackT callback) { matches_.onUnmatched(std::move(callback)); }
+
+    MatchTracker& matchTracker() { return matches_; } // Used by the core
+
+    // Memory held by messages queued on this subscriber
+    virtual MemoryStats getMemoryStats() const { return MemoryStats(); }
+    // Used by the core: enqueue with the message's shared topic charge(s)
+    // (`charges` is parallel to `msgs`), so topic memory counts each message once
+    virtual void enqueueCharged(std::shared_ptr<IMessage> msg, std::shared_ptr<TopicCharge> /*charge*/) {
+        enqueueRaw(std::move(msg));
+    }
+    virtual void enqueueChargedBatch(const std::vector<std::shared_ptr<IMessage>>& msgs,
+                                     const std::vector<std::shared_ptr<TopicCharge>>& /*charges*/) {
+        enqueueRawBatch(msgs);
+    }
+    // Used by the core for topic-wide DropOldest: drops the queue head if it
+    // carries the topic charge with `sequence`. Returns true if it did.
+    virtual bool evictTopicMessage(uint64_t /*sequence*/) { return false; }
+
+    // True if spinOnce() would deliver a queued message (see WaitSet)
+    virtual bool hasPending() const { return false; }
+    ReadyNotifier& readyNotifier() { return ready_; } // Used by WaitSet
+
+private:
+    MatchTracker matches_;
+    ReadyNotifier ready_;
+};
+
+template<class MsgT>
+class Subscriber;
+
+// Handle for the next message on a subscriber, returned by Subscriber::next().
+// Either attach a one-shot handler with then(), or co_await it (see Coroutine.h).
+template<class MsgT>
+struct NextMessage {
+    Subscriber<MsgT>* subscriber;
+
+    // `handler` runs on the subscriber's spinning thread with the next message
+    void then(std::function<void(std::shared_ptr<MsgT>)> handler) {
+        subscriber->addNextHandler(std::move(handler));
+    }
 };
 
 // Templated implementation
 template<class MsgT>
 class Subscriber : public ISubscriber {
 public:
-    Subscriber(const std::string& topic, std::function<void(std::shared_ptr<MsgT>)> callback)
-        : topicName_(topic), callback_(callback) {}
+    using CallbackT = std::function<void(std::shared_ptr<MsgT>)>;
+
+    // `callback` may be empty when messages are only consumed through next().
+    // Latency is measured on `time` (the core's clock) when given.
+    Subscriber(const std::string& topic, CallbackT callback, const TimeSource* time = nullptr)
+        : topicName_(topic), callback_(callback), time_(time) {}
 
     void spinOnce() override {
-        std::shared_ptr<IMessage> rawMsg;
-        if (queue_.try_pop(rawMsg)) {
+        // With nobody to deliver to, leave messages queued for a later next().
+        // The handler lock is only taken while next() waiters exist.
+        bool waiters = nextWaiters_.load(std::memory_order_acquire) != 0;
+        if (!callback_ && !waiters) return;
+
+        QueuedMessage queued;
+        if (queue_.try_pop(queued)) {
+            release(queued.bytes);
+            auto& rawMsg = queued.msg;
             // Performance analysis
             Stopwatch sw;
             auto msg = std::dynamic_pointer_cast<MsgT>(rawMsg);
             if (msg) {
-                callback_(msg);
+                ProfileScope profile(profiling_ ? &profile_ : nullptr);
+                std::vector<CallbackT> handlers;
+                if (waiters) {
+                    std::lock_guard<std::mutex> lock(handlerMutex_);
+                    handlers.swap(nextHandlers_);
+                    nextWaiters_.store(0, std::memory_order_release);
+                }
+                if (callback_) callback_(msg);
+                for (auto& handler : handlers) {
+                    handler(msg);
+                }
             }
             stats_.add(sw.elapsed());
             
             // Calculate latency
-            auto now = std::chrono::high_resolution_clock::now();
+            auto now = time_ ? time_->now() : std::chrono::high_resolution_clock::now();
             std::chrono::duration<double, std::milli> latency = now - rawMsg->timestamp;
             latencyStats_.add(latency.count());
         }
     }
 
     void enqueueRaw(std::shared_ptr<IMessage> msg) override {
-        queue_.push(msg);
+        enqueueCharged(std::move(msg), nullptr);
+    }
+
+    void enqueueRawBatch(const std::vector<std::shared_ptr<IMessage>>& msgs) override {
+        enqueueChargedBatch(msgs, {});
+    }
+
+    void enqueueCharged(std::shared_ptr<IMessage> msg, std::shared_ptr<TopicCharge> charge) override {
+        size_t bytes = msg->byteSize();
+        if (admit(bytes)) {
+            queue_.push(QueuedMessage{std::move(msg), bytes, std::move(charge)});
+            readyNotifier().notify();
+        }
+    }
+
+    void enqueueChargedBatch(const std::vector<std::shared_ptr<IMessage>>& msgs,
+                             const std::vector<std::shared_ptr<TopicCharge>>& charges) override {
+        std::vector<QueuedMessage> admitted;
+        admitted.reserve(msgs.size());
+        for (size_t i = 0; i < msgs.size(); ++i) {
+            size_t bytes = msgs[i]->byteSize();
+            if (admit(bytes)) {
+                admitted.push_back(QueuedMessage{msgs[i], bytes, i < charges.size() ? charges[i] : nullptr});
+            }
+        }
+        queue_.push_bulk(admitted.begin(), admitted.end());
+        if (!admitted.empty()) readyNotifier().notify();
+    }
+
+    bool evictTopicMessage(uint64_t sequence) override {
+        QueuedMessage evicted;
+        if (!queue_.try_pop_if([sequence](const QueuedMessage& queued) {
+                return queued.charge && queued.charge->sequence() == sequence;
+            }, evicted)) {
+            return false;
+        }
+        memory_.remove(evicted.bytes);
+        memory_.recordDrop();
+        return true;
+    }
+
+    // Caps the bytes queued on this subscriber (0 = unlimited)
+    void setByteBudget(size_t maxBytes, OverflowPolicy policy = OverflowPolicy::DropOldest) {
+        memory_.setBudget(maxBytes, policy);
+    }
+
+    MemoryStats getMemoryStats() const override { return memory_.snapshot(); }
+
+    // Only while someone would take the message, so a callback-less
+    // subscriber does not keep a WaitSet spinning
+    bool hasPending() const override {
+        return (callback_ || nextWaiters_.load(std::memory_order_acquire) != 0) && !queue_.empty();
+    }
+
+    // One-shot wait for the next message; see NextMessage
+    NextMessage<MsgT> next() { return NextMessage<MsgT>{this}; }
+
+    void addNextHandler(CallbackT handler) {
+        {
+            std::lock_guard<std::mutex> lock(handlerMutex_);
+            nextHandlers_.push_back(std::move(handler));
+            nextWaiters_.store(nextHandlers_.size(), std::memory_order_release);
+        }
+        // A message may already be waiting for this handler
+        if (!queue_.empty()) readyNotifier().notify();
     }
     
     std::string getTopicName() const override { return topicName_; }
     Statistics getStats() const override { return stats_; }
     Statistics getLatencyStats() const { return latencyStats_; }
+    void setProfilingEnabled(bool enabled) override { profiling_ = enabled; }
+    CallbackProfile getProfile() const override { return profile_; }
 
 private:
+    struct QueuedMessage {
+        std::shared_ptr<IMessage> msg;
+        size_t bytes = 0; // byteSize() at enqueue time
+        std::shared_ptr<TopicCharge> charge; // Topic-wide accounting, shared with other subscribers
+    };
+
+    // Applies the subscriber's own budget; returns false if the incoming
+    // message is dropped. The topic budget is applied by the core before the
+    // message fans out. Enqueues are serialized by the core's topic lock.
+    bool admit(size_t bytes) {
+        while (memory_.wouldExceed(bytes)) {
+            QueuedMessage oldest;
+            if (memory_.policy() == OverflowPolicy::DropOldest && queue_.try_pop(oldest)) {
+                release(oldest.bytes);
+                memory_.recordDrop();
+                continue;
+            }
+            memory_.recordDrop(); // DropNewest, or nothing left to evict
+            return false;
+        }
+        memory_.add(bytes);
+        return true;
+    }
+
+    void release(size_t bytes) {
+        memory_.remove(bytes);
+    }
+
     std::string topicName_;
-    std::function<void(std::shared_ptr<MsgT>)> callback_;
-    ThreadSafeQueue<std::shared_ptr<IMessage>> queue_;
+    CallbackT callback_;
+    const TimeSource* time_;
+    std::mutex handlerMutex_;
+    std::vector<CallbackT> nextHandlers_; // Pending next() waiters
+    std::atomic<size_t> nextWaiters_{0}; // nextHandlers_.size(), read without the lock
+    ThreadSafeQueue<QueuedMessage> queue_;
+    MemoryCounter memory_;
     Statistics stats_; // Callback duration stats
     Statistics latencyStats_; // End-to-end latency stats
+    std::atomic<bool> profiling_{false};
+    CallbackProfile profile_; // CPU time / kernel counters, when profiling
 };
 
 } // namespace mini_ros
\ No newline at end of file
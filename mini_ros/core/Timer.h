@@ -2,41 +2,79 @@
 
 #include <chrono>
 #include <functional>
+#include "Clock.h"
 #include "Statistics.h"
+#include "CallbackProfiler.h"
+#include <atomic>
 
 namespace mini_ros {
 
 class Timer {
 public:
     using CallbackT = std::function<void()>;
-    using Clock = std::chrono::high_resolution_clock;
 
-    Timer(std::chrono::duration<double> period, CallbackT callback)
-        : period_(period), callback_(callback), nextRunTime_(Clock::now() + period) {}
+    // Fires on the core's clock, so timers follow simulated and stepped time
+    Timer(std::chrono::duration<double> period, CallbackT callback, const TimeSource* time)
+        : period_(std::chrono::duration_cast<Clock::Duration>(period)),
+          callback_(callback),
+          time_(time),
+          generation_(time->generation()),
+          nextRunTime_(time->now() + period_) {}
 
     void spinOnce() {
-        auto now = Clock::now();
+        rebaseOnClockChange();
+        auto now = time_->now();
         if (now >= nextRunTime_) {
             Stopwatch sw;
-            callback_();
+            {
+                ProfileScope profile(profiling_ ? &profile_ : nullptr);
+                callback_();
+            }
             stats_.add(sw.elapsed());
 
             // Schedule next run
             nextRunTime_ += period_;
             // Handle timer overruns (if processing took longer than period)
-            if (nextRunNime_ < now) {
+            if (nextRunTime_ < now) {
                 nextRunTime_ = now + period_;
             }
         }
     }
     
+    // Due on the core's clock (see WaitSet)
+    bool isReady() const {
+        rebaseOnClockChange();
+        return time_->now() >= nextRunTime_;
+    }
+    Clock::TimePoint nextRunTime() const {
+        rebaseOnClockChange();
+        return nextRunTime_;
+    }
+    const TimeSource* timeSource() const { return time_; }
+
     Statistics getStats() const { return stats_; }
+    void setProfilingEnabled(bool enabled) { profiling_ = enabled; }
+    CallbackProfile getProfile() const { return profile_; }
 
 private:
-    std::chrono::duration<double> period_;
+    // After the core switches clocks, restart the period on the new clock
+    void rebaseOnClockChange() const {
+        uint64_t generation = time_->generation();
+        if (generation != generation_) {
+            generation_ = generation;
+            nextRunTime_ = time_->now() + period_;
+        }
+    }
+
+    Clock::Duration period_;
     CallbackT callback_;
-    std::chrono::time_point<Clock> nextRunTime_;
+    const TimeSource* time_;
+    // Touched only from the spinning thread; mutable so const queries can re-base
+    mutable uint64_t generation_;
+    mutable Clock::TimePoint nextRunTime_;
     Statistics stats_;
+    std::atomic<bool> profiling_{false};
+    CallbackProfile profile_; // CPU time / kernel counters, when profiling
 };
 
-} // namespace mini_ros
\ No newline at end of file
+} // namespace mini_ros
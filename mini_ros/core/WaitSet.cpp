@@ -0,0 +1,162 @@
+#include "WaitSet.h"
+#include <algorithm>
+
+namespace mini_ros {
+
+namespace {
+
+template<class T>
+void attachTo(std::vector<std::shared_ptr<T>>& entities, std::shared_ptr<T> entity,
+              const std::shared_ptr<WaitSignal>& signal) {
+    if (!entity || std::find(entities.begin(), entities.end(), entity) != entities.end()) return;
+    entity->readyNotifier().attach(signal);
+    entities.push_back(std::move(entity));
+}
+
+template<class T>
+void detachFrom(std::vector<std::shared_ptr<T>>& entities, const std::shared_ptr<T>& entity,
+                const WaitSignal* signal) {
+    auto it = std::find(entities.begin(), entities.end(), entity);
+    if (it == entities.end()) return;
+    (*it)->readyNotifier().detach(signal);
+    entities.erase(it);
+}
+
+template<class T>
+void detachAll(std::vector<std::shared_ptr<T>>& entities, const WaitSignal* signal) {
+    for (auto& entity : entities) {
+        entity->readyNotifier().detach(signal);
+    }
+    entities.clear();
+}
+
+} // namespace
+
+WaitSet::WaitSet() : signal_(std::make_shared<WaitSignal>()) {}
+
+WaitSet::~WaitSet() {
+    clear();
+}
+
+void WaitSet::add(std::shared_ptr<ISubscriber> subscriber) {
+    attachTo(subscribers_, std::move(subscriber), signal_);
+}
+
+void WaitSet::add(std::shared_ptr<IServiceServer> server) {
+    attachTo(serviceServers_, std::move(server), signal_);
+}
+
+void WaitSet::add(std::shared_ptr<Timer> timer) {
+    // Timers are polled against their clock; there is nothing to attach
+    if (timer && std::find(timers_.begin(), timers_.end(), timer) == timers_.end()) {
+        timers_.push_back(std::move(timer));
+    }
+}
+
+void WaitSet::add(std::shared_ptr<GuardCondition> guard) {
+    attachTo(guardConditions_, std::move(guard), signal_);
+}
+
+void WaitSet::add(std::shared_ptr<PendingResponse> response) {
+    attachTo(responses_, std::move(response), signal_);
+}
+
+void WaitSet::remove(const std::shared_ptr<ISubscriber>& subscriber) {
+    detachFrom(subscribers_, subscriber, signal_.get());
+}
+
+void WaitSet::remove(const std::shared_ptr<IServiceServer>& server) {
+    detachFrom(serviceServers_, server, signal_.get());
+}
+
+void WaitSet::remove(const std::shared_ptr<Timer>& timer) {
+    timers_.erase(std::remove(timers_.begin(), timers_.end(), timer), timers_.end());
+}
+
+void WaitSet::remove(const std::shared_ptr<GuardCondition>& guard) {
+    detachFrom(guardConditions_, guard, signal_.get());
+}
+
+void WaitSet::remove(const std::shared_ptr<PendingResponse>& response) {
+    detachFrom(responses_, response, signal_.get());
+}
+
+void WaitSet::clear() {
+    detachAll(subscribers_, signal_.get());
+    detachAll(serviceServers_, signal_.get());
+    detachAll(guardConditions_, signal_.get());
+    detachAll(responses_, signal_.get());
+    timers_.clear();
+}
+
+WaitResult WaitSet::wait(std::chrono::duration<double> timeout) {
+    using SteadyClock = WaitSignal::SteadyClock;
+
+    WaitResult result;
+    if (subscribers_.empty() && serviceServers_.empty() && timers_.empty() &&
+        guardConditions_.empty() && responses_.empty()) {
+        result.kind = WaitResult::Kind::Empty;
+        return result;
+    }
+
+    auto deadline = timeout.count() < 0.0
+        ? SteadyClock::time_point::max()
+        : SteadyClock::now() + std::chrono::duration_cast<SteadyClock::duration>(timeout);
+
+    for (;;) {
+        // Read the generation before checking, so a notify in between is not lost
+        uint64_t seen = signal_->generation();
+        if (collect(result)) {
+            result.kind = WaitResult::Kind::Ready;
+            return result;
+        }
+        auto now = SteadyClock::now();
+        if (now >= deadline) {
+            result.kind = WaitResult::Kind::Timeout;
+            return result;
+        }
+        signal_->waitUntil(seen, nextTimerWake(deadline));
+    }
+}
+
+bool WaitSet::collect(WaitResult& result) {
+    for (auto& subscriber : subscribers_) {
+        if (subscriber->hasPending()) result.subscribers.push_back(subscriber);
+    }
+    for (auto& server : serviceServers_) {
+        if (server->hasPending()) result.serviceServers.push_back(server);
+    }
+    for (auto& timer : timers_) {
+        if (timer->isReady()) result.timers.push_back(timer);
+    }
+    for (auto& guard : guardConditions_) {
+        if (guard->consume()) result.guardConditions.push_back(guard);
+    }
+    for (auto& response : responses_) {
+        if (response->isReady()) result.responses.push_back(response);
+    }
+    return !result.subscribers.empty() || !result.serviceServers.empty() || !result.timers.empty() ||
+           !result.guardConditions.empty() || !result.responses.empty();
+}
+
+WaitSignal::SteadyClock::time_point WaitSet::nextTimerWake(WaitSignal::SteadyClock::time_point limit) const {
+    using SteadyClock = WaitSignal::SteadyClock;
+
+    auto now = SteadyClock::now();
+    auto wake = limit;
+    for (const auto& timer : timers_) {
+        const TimeSource* time = timer->timeSource();
+        SteadyClock::time_point due;
+        if (std::dynamic_pointer_cast<SteppedClock>(time->get())) {
+            // Simulated time can jump at any moment; re-check in short real-time slices
+            due = now + std::chrono::milliseconds(1);
+        } else {
+            auto remaining = std::max(timer->nextRunTime() - time->now(), Clock::Duration::zero());
+            due = now + std::chrono::duration_cast<SteadyClock::duration>(remaining);
+        }
+        wake = std::min(wake, due);
+    }
+    return wake;
+}
+
+} // namespace mini_ros
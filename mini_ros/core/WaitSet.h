@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Subscriber.h"
+#include "ServiceServer.h"
+#include "ServiceClient.h"
+#include "Timer.h"
+#include "WaitSignal.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace mini_ros {
+
+// Manually triggered wake-up for a WaitSet, e.g. to interrupt a control loop
+// from another thread. Reported once per trigger().
+class GuardCondition {
+public:
+    void trigger() {
+        triggered_.store(true, std::memory_order_release);
+        notifier_.notify();
+    }
+
+    bool isTriggered() const { return triggered_.load(std::memory_order_acquire); }
+    // Clears the trigger; returns whether it was set
+    bool consume() { return triggered_.exchange(false, std::memory_order_acq_rel); }
+
+    ReadyNotifier& readyNotifier() { return notifier_; } // Used by WaitSet
+
+private:
+    std::atomic<bool> triggered_{false};
+    ReadyNotifier notifier_;
+};
+
+// Entities that were ready when WaitSet::wait() returned
+struct WaitResult {
+    enum class Kind { Ready, Timeout, Empty };
+
+    Kind kind = Kind::Timeout;
+    std::vector<std::shared_ptr<ISubscriber>> subscribers;       // Have queued messages
+    std::vector<std::shared_ptr<IServiceServer>> serviceServers; // Have queued calls
+    std::vector<std::shared_ptr<Timer>> timers;                  // Are due
+    std::vector<std::shared_ptr<GuardCondition>> guardConditions; // Were triggered
+    std::vector<std::shared_ptr<PendingResponse>> responses;     // Have completed
+
+    bool ready() const { return kind == Kind::Ready; }
+};
+
+// Blocks a self-driven control loop until any attached entity is ready or a
+// timeout passes, instead of busy-polling spinOnce(). All entities wake the
+// same condition variable, so a wait costs one kernel sleep regardless of
+// how many entities are attached. wait() only reports readiness; the caller
+// then spins the reported subscribers, servers and timers itself.
+//
+// A WaitSet is used from one thread. Entities may become ready from any thread.
+class WaitSet {
+public:
+    WaitSet();
+    ~WaitSet();
+
+    WaitSet(const WaitSet&) = delete;
+    WaitSet& operator=(const WaitSet&) = delete;
+
+    void add(std::shared_ptr<ISubscriber> subscriber);
+    void add(std::shared_ptr<IServiceServer> server);
+    void add(std::shared_ptr<Timer> timer);
+    void add(std::shared_ptr<GuardCondition> guard);
+    void add(std::shared_ptr<PendingResponse> response);
+
+    void remove(const std::shared_ptr<ISubscriber>& subscriber);
+    void remove(const std::shared_ptr<IServiceServer>& server);
+    void remove(const std::shared_ptr<Timer>& timer);
+    void remove(const std::shared_ptr<GuardCondition>& guard);
+    void remove(const std::shared_ptr<PendingResponse>& response);
+    void clear();
+
+    // Waits until something is ready or `timeout` passes (negative = forever).
+    // Returns Kind::Empty immediately if nothing is attached. Reported guard
+    // conditions are consumed; other entities stay ready until handled.
+    WaitResult wait(std::chrono::duration<double> timeout = std::chrono::duration<double>(-1.0));
+
+private:
+    // Fills `result` with ready entities; returns true if any were found
+    bool collect(WaitResult& result);
+    // Real-time point by which the earliest attached timer may be due
+    WaitSignal::SteadyClock::time_point nextTimerWake(WaitSignal::SteadyClock::time_point limit) const;
+
+    std::shared_ptr<WaitSignal> signal_;
+    std::vector<std::shared_ptr<ISubscriber>> subscribers_;
+    std::vector<std::shared_ptr<IServiceServer>> serviceServers_;
+    std::vector<std::shared_ptr<Timer>> timers_;
+    std::vector<std::shared_ptr<GuardCondition>> guardConditions_;
+    std::vector<std::shared_ptr<PendingResponse>> responses_;
+};
+
+} // namespace mini_ros
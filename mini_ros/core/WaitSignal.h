@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mini_ros {
+
+// The single blocking point of a WaitSet. Every attached entity bumps the
+// generation when it becomes ready; the waiter sleeps until it changes.
+class WaitSignal {
+public:
+    using SteadyClock = std::chrono::steady_clock;
+
+    void notify() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++generation_;
+        }
+        cond_var_.notify_all();
+    }
+
+    uint64_t generation() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return generation_;
+    }
+
+    // Returns false if `deadline` passed with the generation still at `seen`
+    bool waitUntil(uint64_t seen, SteadyClock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_var_.wait_until(lock, deadline, [&]{ return generation_ != seen; });
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable cond_var_;
+    uint64_t generation_ = 0;
+};
+
+// Entity side of a WaitSet: the signals to poke when the entity becomes
+// ready. notify() is a single atomic load while nothing is attached, so
+// entities that never join a WaitSet pay almost nothing.
+class ReadyNotifier {
+public:
+    void attach(const std::shared_ptr<WaitSignal>& signal) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        signals_.push_back(signal);
+        active_.store(true, std::memory_order_release);
+    }
+
+    void detach(const WaitSignal* signal) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = signals_.begin(); it != signals_.end();) {
+            auto locked = it->lock();
+            if (!locked || locked.get() == signal) {
+                it = signals_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        active_.store(!signals_.empty(), std::memory_order_release);
+    }
+
+    void notify() {
+        if (!active_.load(std::memory_order_acquire)) return;
+        std::vector<std::shared_ptr<WaitSignal>> signals;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& weak : signals_) {
+                if (auto signal = weak.lock()) signals.push_back(std::move(signal));
+            }
+        }
+        for (auto& signal : signals) {
+            signal->notify();
+        }
+    }
+
+private:
+    std::atomic<bool> active_{false};
+    std::mutex mutex_;
+    std::vector<std::weak_ptr<WaitSignal>> signals_;
+};
+
+} // namespace mini_ros
@@ -0,0 +1,307 @@
+// mini_ros_loadgen: open-loop load generator for capacity planning.
+//
+// Publishers follow a fixed schedule (open loop): message k on a thread is
+// due at start + k * interval whether or not earlier sends were delayed. A
+// stalled system therefore builds a backlog instead of silently slowing the
+// generator down. Latency is measured from the *intended* send time, which
+// corrects for coordinated omission; the uncorrected latency (from the actual
+// publish timestamp) is reported alongside for comparison.
+//
+// With --sweep, the offered rate is raised stage by stage until the corrected
+// latency percentile breaks the SLO or throughput falls behind the offered
+// rate. The last passing stage is the saturation point.
+
+#include "mini_ros/core/Node.h"
+#include "mini_ros/core/MiniRosCore.h"
+#include "mini_ros/common/LatencyHistogram.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mini_ros;
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        SteadyClock::now().time_since_epoch()).count();
+}
+
+struct LoadMessage : public IMessage {
+    int64_t intendedNanos = 0; // Scheduled send time (steady clock)
+    int64_t sentNanos = 0;     // Actual send time (steady clock)
+    std::vector<uint8_t> payload;
+
+    size_t byteSize() const override { return sizeof(*this) + payload.capacity(); }
+};
+
+struct Options {
+    int topics = 1;
+    int threads = 1;
+    double rate = 1000.0;       // Total messages/s across all topics
+    double duration = 5.0;      // Seconds per stage
+    size_t payload = 64;        // Bytes per message
+    bool sweep = false;
+    double stepFactor = 1.5;    // Rate multiplier between sweep stages
+    double maxRate = 1e7;
+    double sloMs = 10.0;        // Latency SLO for the sweep
+    double percentile = 99.0;   // Percentile the SLO applies to
+    int consumerThreads = 1;
+};
+
+struct TopicResult {
+    std::string topic;
+    uint64_t offered = 0;
+    uint64_t received = 0;
+    double throughput = 0.0;
+    uint64_t corrected[4] = {}; // p50, p99, p99.9, max (ns)
+    uint64_t uncorrected[4] = {};
+    uint64_t atSloPercentile = 0; // Corrected latency at --percentile (ns)
+};
+
+struct TopicState {
+    std::string name;
+    std::atomic<uint64_t> sent{0};
+    LatencyHistogram corrected;
+    LatencyHistogram uncorrected;
+};
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --topics N          topics to publish on (default 1)\n"
+              << "  --threads M         publisher threads (default 1)\n"
+              << "  --consumers C       threads spinning subscriber nodes (default 1)\n"
+              << "  --rate R            total offered rate in msgs/s (default 1000)\n"
+              << "  --duration S        seconds per stage (default 5)\n"
+              << "  --payload BYTES     payload size (default 64)\n"
+              << "  --sweep             raise the rate until the SLO breaks\n"
+              << "  --step-factor F     rate multiplier per sweep stage (default 1.5)\n"
+              << "  --max-rate R        stop the sweep at this rate (default 1e7)\n"
+              << "  --slo-ms MS         latency SLO in milliseconds (default 10)\n"
+              << "  --percentile P      percentile the SLO applies to (default 99)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* value = nullptr;
+        if (arg == "--sweep") {
+            opts.sweep = true;
+            continue;
+        }
+        if (!(value = next())) return false;
+        if (arg == "--topics") opts.topics = std::max(1, std::atoi(value));
+        else if (arg == "--threads") opts.threads = std::max(1, std::atoi(value));
+        else if (arg == "--consumers") opts.consumerThreads = std::max(1, std::atoi(value));
+        else if (arg == "--rate") opts.rate = std::atof(value);
+        else if (arg == "--duration") opts.duration = std::atof(value);
+        else if (arg == "--payload") opts.payload = static_cast<size_t>(std::atoll(value));
+        else if (arg == "--step-factor") opts.stepFactor = std::atof(value);
+        else if (arg == "--max-rate") opts.maxRate = std::atof(value);
+        else if (arg == "--slo-ms") opts.sloMs = std::atof(value);
+        else if (arg == "--percentile") opts.percentile = std::atof(value);
+        else return false;
+    }
+    return opts.rate > 0.0 && opts.duration > 0.0 && opts.stepFactor > 1.0;
+}
+
+// Runs one stage at `rate` msgs/s in a fresh context and returns per-topic results
+std::vector<TopicResult> runStage(const Options& opts, double rate) {
+    Context context;
+    Node producer("loadgen_producer", context);
+
+    std::vector<std::unique_ptr<TopicState>> topics;
+    std::vector<std::shared_ptr<Publisher>> publishers;
+    for (int t = 0; t < opts.topics; ++t) {
+        topics.push_back(std::make_unique<TopicState>());
+        topics.back()->name = "loadgen/topic_" + std::to_string(t);
+        publishers.push_back(producer.createPublisher<LoadMessage>(topics.back()->name));
+    }
+
+    // One consumer node per consumer thread; topics are dealt round-robin
+    std::vector<std::unique_ptr<Node>> consumers;
+    for (int c = 0; c < opts.consumerThreads; ++c) {
+        consumers.push_back(std::make_unique<Node>("loadgen_consumer_" + std::to_string(c), context));
+    }
+    for (int t = 0; t < opts.topics; ++t) {
+        TopicState* state = topics[t].get();
+        consumers[t % consumers.size()]->createSubscriber<LoadMessage>(state->name,
+            [state](std::shared_ptr<LoadMessage> msg) {
+                int64_t now = steadyNanos();
+                state->corrected.record(now - msg->intendedNanos);
+                state->uncorrected.record(now - msg->sentNanos);
+            });
+    }
+
+    std::atomic<bool> consuming{true};
+    std::vector<std::thread> consumerThreads;
+    for (auto& consumer : consumers) {
+        Node* node = consumer.get();
+        consumerThreads.emplace_back([node, &consuming]() {
+            while (consuming) {
+                node->spinOnce();
+            }
+        });
+    }
+
+    // Each publisher thread owns an equal share of the rate and a fixed set of topics
+    // The schedule is computed in floating point: a whole-nanosecond interval
+    // would drift at high rates and round to 0 above 1e9 msgs/s per thread
+    const double perThreadRate = rate / opts.threads;
+    const double intervalNanos = 1e9 / perThreadRate;
+    const auto start = SteadyClock::now() + std::chrono::milliseconds(10);
+    const auto end = start + std::chrono::duration_cast<SteadyClock::duration>(
+        std::chrono::duration<double>(opts.duration));
+
+    std::vector<std::thread> producerThreads;
+    for (int p = 0; p < opts.threads; ++p) {
+        producerThreads.emplace_back([&, p]() {
+            std::vector<int> myTopics;
+            for (int t = p % opts.topics; t < opts.topics; t += opts.threads) myTopics.push_back(t);
+            if (myTopics.empty()) myTopics.push_back(p % opts.topics);
+
+            // Stagger threads so their schedules interleave
+            const double offsetNanos = intervalNanos * p / opts.threads;
+            for (uint64_t k = 0;; ++k) {
+                auto intended = start + std::chrono::duration_cast<SteadyClock::duration>(
+                    std::chrono::duration<double, std::nano>(offsetNanos + intervalNanos * k));
+                if (intended >= end) break;
+                auto now = SteadyClock::now();
+                if (now < intended) {
+                    // Sleep most of the gap, spin the last stretch for precision
+                    if (intended - now > std::chrono::microseconds(200)) {
+                        std::this_thread::sleep_until(intended - std::chrono::microseconds(100));
+                    }
+                    while (SteadyClock::now() < intended) {
+                    }
+                }
+                // Behind schedule: send immediately, never skip (open loop)
+                int t = myTopics[k % myTopics.size()];
+                auto msg = std::make_shared<LoadMessage>();
+                msg->payload.resize(opts.payload);
+                msg->intendedNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    intended.time_since_epoch()).count();
+                msg->sentNanos = steadyNanos();
+                publishers[t]->publish(msg);
+                topics[t]->sent++;
+            }
+        });
+    }
+    for (auto& thread : producerThreads) thread.join();
+
+    // Drain: give consumers up to one stage length to catch up on the backlog
+    auto drainDeadline = SteadyClock::now() + std::chrono::duration_cast<SteadyClock::duration>(
+        std::chrono::duration<double>(opts.duration));
+    auto allReceived = [&]() {
+        for (auto& topic : topics) {
+            if (topic->corrected.count() < topic->sent) return false;
+        }
+        return true;
+    };
+    while (!allReceived() && SteadyClock::now() < drainDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double elapsed = std::chrono::duration<double>(SteadyClock::now() - start).count();
+
+    consuming = false;
+    for (auto& thread : consumerThreads) thread.join();
+    context.shutdown();
+
+    std::vector<TopicResult> results;
+    for (auto& topic : topics) {
+        TopicResult result;
+        result.topic = topic->name;
+        result.offered = topic->sent;
+        result.received = topic->corrected.count();
+        result.throughput = result.received / elapsed;
+        const double points[3] = {50.0, 99.0, 99.9};
+        for (int i = 0; i < 3; ++i) {
+            result.corrected[i] = topic->corrected.percentile(points[i]);
+            result.uncorrected[i] = topic->uncorrected.percentile(points[i]);
+        }
+        result.corrected[3] = topic->corrected.max();
+        result.uncorrected[3] = topic->uncorrected.max();
+        result.atSloPercentile = topic->corrected.percentile(opts.percentile);
+        results.push_back(result);
+    }
+    return results;
+}
+
+void printHeader() {
+    std::cout << std::left << std::setw(12) << "rate" << std::setw(22) << "topic"
+              << std::right << std::setw(12) << "tput/s" << std::setw(10) << "lost"
+              << std::setw(11) << "p50_ms" << std::setw(11) << "p99_ms" << std::setw(11) << "p999_ms"
+              << std::setw(11) << "max_ms" << std::setw(14) << "raw_p99_ms" << std::endl;
+}
+
+void printResults(double rate, const std::vector<TopicResult>& results) {
+    std::cout << std::fixed;
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(12) << std::setprecision(0) << rate << std::setw(22) << r.topic
+                  << std::right << std::setw(12) << std::setprecision(0) << r.throughput
+                  << std::setw(10) << (r.offered - r.received) << std::setprecision(3)
+                  << std::setw(11) << r.corrected[0] * 1e-6 << std::setw(11) << r.corrected[1] * 1e-6
+                  << std::setw(11) << r.corrected[2] * 1e-6 << std::setw(11) << r.corrected[3] * 1e-6
+                  << std::setw(14) << r.uncorrected[1] * 1e-6 << std::endl;
+    }
+}
+
+// A stage passes if every topic met the SLO and received what was offered
+bool stagePasses(const Options& opts, const std::vector<TopicResult>& results) {
+    for (const auto& r : results) {
+        if (r.received < r.offered) return false;
+    }
+    for (const auto& r : results) {
+        if (r.atSloPercentile * 1e-6 > opts.sloMs) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parseOptions(argc, argv, opts)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "Open-loop load: " << opts.topics << " topic(s), " << opts.threads
+              << " publisher thread(s), " << opts.consumerThreads << " consumer thread(s), "
+              << opts.payload << " B payload, " << opts.duration << " s/stage" << std::endl;
+    std::cout << "Latencies are from the intended send time (coordinated-omission corrected); "
+              << "raw_p99 is from the actual send time." << std::endl;
+    printHeader();
+
+    double rate = opts.rate;
+    double lastPassing = 0.0;
+    for (;;) {
+        auto results = runStage(opts, rate);
+        printResults(rate, results);
+        bool passed = stagePasses(opts, results);
+        if (passed) lastPassing = rate;
+        if (!opts.sweep || !passed) break;
+        rate *= opts.stepFactor;
+        if (rate > opts.maxRate) break;
+    }
+
+    if (opts.sweep) {
+        if (lastPassing > 0.0) {
+            std::cout << std::defaultfloat << "Saturation: highest rate meeting p" << opts.percentile
+                      << " <= " << opts.sloMs << " ms was " << std::fixed << std::setprecision(0) << lastPassing << " msgs/s" << std::endl;
+        } else {
+            std::cout << "Saturation: the starting rate already breaks the SLO" << std::endl;
+        }
+    }
+    return 0;
+}